@@ -13,9 +13,17 @@
 
 
 
-#include <windows.h>
 #include <memory>
 #include <functional>
+#include <new>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <tuple>
+#include <iterator>
+#include <vector>
+#include <optional>
+#include <winpool_platform.hxx>
 
 
 
@@ -29,7 +37,18 @@ namespace WinpoolNS {
 class Worker;
 class Future;
 class FutureList;
+class FutureDeque;
+class InjectionQueue;
+class FutureSlab;
+class FutureBatch;
+class TaskGroup;
+class TaskGraph;
+class BlockingRegion;
+class Timer;
+class CancelState;
 class Winpool;
+template<class T> class TypedFuture;
+template<class T> class WhenAnyResult;
 
 /* FutureOwner: Winpool class needs the same members as worker, so we'll
                 call it a FutureOwner there. */
@@ -42,6 +61,99 @@ using UniquePtr = std::unique_ptr<T>;
 /* WinpoolTask: Cleaner name for void *(void *) */
 using WinpoolTask = std::function<void *(void *)>;
 
+/* GraphTask: Callable run by a TaskGraph node. */
+using GraphTask = std::function<void()>;
+
+/* TimerTask: Callable run by a Timer every time it fires. */
+using TimerTask = std::function<void()>;
+
+/* taskStorageSize: Bytes of callable a Future can hold inline. Bigger 
+                    callables are moved to the heap. */
+const size_t taskStorageSize = 48;
+
+/* splitCheckInterval: Most iterations parallelFor and parallelReduce run 
+                       between checks for whether to split the rest of their
+                       range off for thieves. */
+const int64_t splitCheckInterval = 32;
+
+/* minSplitNs: parallelFor and parallelReduce don't split off pieces that 
+               look like less work than this - about what it costs to hand a
+               task to a sleeping worker. */
+const uint64_t minSplitNs = 10000;
+
+/* workerHeadroom: createNew(nThreads) leaves room for this many times 
+                   nThreads workers, for setWorkerCount and for workers 
+                   compensating for blocked ones. */
+const int workerHeadroom = 2;
+
+/* agingPeriod: Keeps the lower priority lanes of the pool's queue from 
+                starving: about one pop in agingPeriod tries the NORMAL lane
+                first, one in agingPeriod^2 the LOW lane. */
+const uint64_t agingPeriod = 8;
+
+/* shutdownPollNs: Longest shutdown sleeps between checks for the workers 
+                   to run out of work, should a wakeup get lost. */
+const uint64_t shutdownPollNs = 1000000;
+
+/* timerTickNs: Resolution of the pool's timers. Deadlines are rounded up to
+                a whole tick. */
+const uint64_t timerTickNs = 1000000;
+
+/* timerWheelBits: log2 of timerWheelSlots. */
+const int timerWheelBits = 6;
+
+/* timerWheelSlots: Slots per level of the timer wheel. At most 64, since 
+                    each level keeps a 64-bit mask of its non-empty slots. */
+const int timerWheelSlots = 1 << timerWheelBits;
+
+/* timerWheelLevels: Levels of the timer wheel. Together they span 
+                     timerWheelSlots^timerWheelLevels ticks (about 12 days);
+                     timers due later go round the top level again. */
+const int timerWheelLevels = 5;
+
+/* TaskResult: Type of the result a task calling func(args...) leaves in its
+               Future. */
+template<class F, class... Args>
+using TaskResult = typename std::decay<
+    typename std::invoke_result<
+        typename std::decay<F>::type, 
+        typename std::decay<Args>::type...
+    >::type
+>::type;
+
+/* ThenResult: Type of the result a continuation func leaves in its Future,
+                when it's passed the result (of type T) of the task it 
+                follows. */
+template<class T, class F>
+using ThenResult = typename std::decay<
+    typename std::conditional<
+        std::is_void<T>::value,
+        std::invoke_result<typename std::decay<F>::type>,
+        std::invoke_result<typename std::decay<F>::type, T>
+    >::type::type
+>::type;
+
+/* TryGetResult: What TypedFuture<T>::tryGet returns: the result if the task
+                 was done, or nothing. Just whether it was done for void. */
+template<class T>
+using TryGetResult = typename std::conditional<
+    std::is_void<T>::value,
+    bool,
+    std::optional<T>
+>::type;
+
+/* IsLegacySubmit: True for submit(func, arg) calls that the untyped 
+                   submit(WinpoolTask, void *) takes care of. */
+template<class F, class... Args>
+class IsLegacySubmit : public std::false_type {};
+
+template<class F, class Arg>
+class IsLegacySubmit<F, Arg> : public std::integral_constant<
+    bool, 
+    std::is_convertible<F, WinpoolTask>::value && 
+        std::is_convertible<Arg, void *>::value
+> {};
+
 
 
 /**
@@ -50,13 +162,16 @@ using WinpoolTask = std::function<void *(void *)>;
  * Base function run by the worker thread processes.
  * Loops, searching for tasks in the pool's queue and the other workers' 
  * queues and executing them until the pool shuts down.
+ * When there is nothing to do, a worker keeps searching for a while, then 
+ * yields, then goes to sleep on the pool's idleWorkers until a task is
+ * submitted (or, for one of them, until the next timer is due). Workers 
+ * in slots at or above the pool's activeTarget park instead, once their 
+ * own deque is empty.
  * 
  * arg: Borrowed pointer to a WorkerTProcData instance that contains data about
  *      the pool and about the running thread.
- * 
- * Return Value: Doesn't matter
  */
-DWORD WINAPI workerTProc(void *arg);
+void workerTProc(void *arg);
 
 
 
@@ -68,20 +183,31 @@ DWORD WINAPI workerTProc(void *arg);
 class SyscallError final {
 public:
 
-    /* error: Error code returned by GetLastError. */
-    DWORD error;
+    /* error: Error code returned by lastErrorCode. */
+    ErrorCode error;
 
 
     /**
      * SyscallError constructor
      * 
-     * error: Error code returned by GetLastError
+     * error: Error code returned by lastErrorCode
      */
-    SyscallError(DWORD error);
+    SyscallError(ErrorCode error);
 };
 
 
 
+/**
+ * TaskCancelled class
+ * 
+ * Exception class thrown by TypedFuture::get when the task was cancelled. 
+ * A task from submit or then that throws it (or lets it through) gives 
+ * up: its own Future completes as cancelled.
+ */
+class TaskCancelled final {};
+
+
+
 /**
  * WorkerTProcData class
  * 
@@ -93,7 +219,7 @@ public:
 
     Winpool *pool;
 
-    DWORD tlsMyWorkerIdx;
+    TlsSlot *workerTls;
 
     Worker *myWorker;
 
@@ -103,10 +229,260 @@ public:
      * 
      * Justs sets the members.
      */
-    WorkerTProcData(Winpool *pool, DWORD tlsMyWorkerIdx, Worker *myWorker);
+    WorkerTProcData(Winpool *pool, TlsSlot *workerTls, Worker *myWorker);
+};
+
+
+/**
+ * FutureSlabBlock class
+ * 
+ * Header in front of every Future's memory, linking it back to the slab it
+ * was carved from. Padded so the Future behind it stays aligned.
+ */
+class alignas(std::max_align_t) FutureSlabBlock final {
+public:
+
+    /* home: Slab the block belongs to, nullptr if the block came from the 
+             global heap (Futures created by external threads). */
+    FutureSlab *home;
+
+    /* next: Next block in a free list. Only meaningful while the block is 
+             free. */
+    FutureSlabBlock *next;
+
+    /* batch: FutureBatch whose allocation the block is part of, nullptr for
+              blocks from a slab or the global heap. */
+    FutureBatch *batch;
+};
+
+
+
+/**
+ * AllocatorStats class
+ * 
+ * Future allocator counters, summed over all workers by 
+ * Winpool::allocatorStats.
+ */
+class AllocatorStats final {
+public:
+
+    /* nChunks: Chunks taken from the global heap. Stops growing once 
+                spawning reaches a steady state. */
+    uint64_t nChunks;
+
+    /* nAllocs: Futures handed out from slabs. */
+    uint64_t nAllocs;
+
+    /* nLocalFrees: Futures freed by the worker that allocated them. */
+    uint64_t nLocalFrees;
+
+    /* nRemoteFrees: Futures freed by some other thread and sent back to 
+                     their slab. */
+    uint64_t nRemoteFrees;
+};
+
+
+
+/**
+ * JoinStats class
+ * 
+ * Counters for Future::get calls made on worker threads, summed over all 
+ * workers by Winpool::joinStats.
+ */
+class JoinStats final {
+public:
+
+    /* nWaits: Joins that found their Future not done yet. */
+    uint64_t nWaits;
+
+    /* nHelps: Tasks run by workers while they were joining. */
+    uint64_t nHelps;
+
+    /* wastedNs: Time joining workers spent with nothing to run. */
+    uint64_t wastedNs;
+};
+
+
+
+/**
+ * WorkerStats class
+ * 
+ * Scheduler counters of one worker (or their sum), reported by 
+ * Winpool::stats. They only ever grow: scrape them periodically and look
+ * at the differences.
+ */
+class WorkerStats final {
+public:
+
+    /* nTasks: Tasks run, including those run while joining. */
+    uint64_t nTasks;
+
+    /* nCancelled: Cancelled tasks skipped instead of run. */
+    uint64_t nCancelled;
+
+    /* nQueuePops: Tasks taken from the pool's queue. */
+    uint64_t nQueuePops;
+
+    /* nStealAttempts: Steals tried on other workers' deques that weren't 
+                       empty. */
+    uint64_t nStealAttempts;
+
+    /* nSteals: Steals that got a task. */
+    uint64_t nSteals;
+
+    /* nYields: Times an idle worker yielded its CPU before sleeping. */
+    uint64_t nYields;
+
+    /* nSleeps: Times the worker went to sleep for lack of work, or 
+                parked. */
+    uint64_t nSleeps;
+
+    /* sleepNs: Time spent asleep for lack of work. */
+    uint64_t sleepNs;
+
+    /* parkedNs: Time spent parked. */
+    uint64_t parkedNs;
+
+    /* nJoinWaits: Joins that found their Future not done yet. */
+    uint64_t nJoinWaits;
+
+    /* joinNs: Time spent in those joins, helping or not. Joins made while
+              helping another join are part of it and not counted 
+              again. */
+    uint64_t joinNs;
+
+    /* joinWastedNs: Part of joinNs with nothing to run. */
+    uint64_t joinWastedNs;
+
+    /* lockWaitNs: Time spent taking the timer wheel's lock. */
+    uint64_t lockWaitNs;
+};
+
+
+
+/**
+ * SchedulerStats class
+ * 
+ * Result of Winpool::stats.
+ */
+class SchedulerStats final {
+public:
+
+    /* workers: Counters of every worker that was ever started, by slot. */
+    std::vector<WorkerStats> workers;
+
+    /* total: Sum of workers. */
+    WorkerStats total;
+};
+
+
+
+/**
+ * FutureSlab class
+ * 
+ * Per-worker allocator for Future objects. Only the owning worker thread 
+ * allocates from a slab; it carves Futures out of large chunks and recycles
+ * them through a private free list, so spawning never touches the global 
+ * heap once enough chunks exist. Futures freed by any other thread are 
+ * pushed onto the slab's remoteFree stack, which the owner takes over in 
+ * one exchange when its free list runs dry.
+ * 
+ * A slab outlives its worker until every Future carved from it is freed 
+ * (see orphan).
+ */
+class FutureSlab final {
+public:
+
+    /* tlsMySlab: The calling thread's slab, nullptr outside worker threads.
+                  Future::operator new allocates from it. */
+    static thread_local FutureSlab *tlsMySlab;
+
+    /* freeList: Blocks freed by the owner. Owner only. */
+    FutureSlabBlock *freeList;
+
+    /* carveNext: Next never-used block in the newest chunk. Owner only. */
+    char *carveNext;
+
+    /* nCarveLeft: Number of never-used blocks left in the newest chunk. 
+                   Owner only. */
+    int nCarveLeft;
+
+    /* chunks: Every chunk this slab allocated, linked through their first 
+               word. */
+    void *chunks;
+
+    /* remoteFree: Blocks freed by other threads (lock-free stack). */
+    alignas(64) std::atomic<FutureSlabBlock *> remoteFree;
+
+    /* remoteBalance: Remote frees subtract 1; orphan adds the number of
+                      blocks not freed by the owner. Whoever brings it back to
+                      0 after orphan deletes the slab. */
+    std::atomic<int64_t> remoteBalance;
+
+    /* Counters reported by Winpool::allocatorStats. Only the owner writes
+       the first three (plain load + store), so they cost no atomic 
+       read-modify-write. */
+    alignas(64) std::atomic<uint64_t> nChunks;
+    std::atomic<uint64_t> nAllocs;
+    std::atomic<uint64_t> nLocalFrees;
+    std::atomic<uint64_t> nRemoteFrees;
+
+
+    /**
+     * FutureSlab constructor
+     * 
+     * Creates an empty slab. No memory is allocated until the first alloc.
+     */
+    FutureSlab();
+
+    /**
+     * FutureSlab destructor
+     * 
+     * Frees all chunks. Only called once every block is free - use orphan.
+     */
+    ~FutureSlab();
+
+    FutureSlab(const FutureSlab &) = delete;
+    FutureSlab &operator=(const FutureSlab &) = delete;
+
+    /**
+     * FutureSlab::alloc
+     * 
+     * Hands out a block big enough for a Future. Owner only.
+     * 
+     * Return Value: Returns a pointer to the Future memory (just past the 
+     *               block's header).
+     */
+    void *alloc();
+
+    /**
+     * FutureSlab::free
+     * 
+     * Returns a block to this slab. Any thread may call this.
+     * 
+     * block: Header of the block to free.
+     */
+    void free(FutureSlabBlock *block);
+
+    /**
+     * FutureSlab::orphan
+     * 
+     * Called instead of delete when the owning worker goes away. The slab 
+     * deletes itself as soon as every block carved from it has been freed,
+     * which may be right away.
+     */
+    void orphan();
+
+    /**
+     * FutureSlab::collectStats
+     * 
+     * Adds this slab's counters to stats.
+     */
+    void collectStats(AllocatorStats *stats);
 };
 
 
+
 /**
  * FutureStatus enum
  */
@@ -114,51 +490,85 @@ typedef enum _FutureStatus {
     QUEUED,
     RUNNING,
     DONE,
+    CANCELLED, // Cancelled while QUEUED: the executor skips the task
     SENTINEL // Only used for FutureList stuff
 } FutureStatus;
 
 
 
+/**
+ * TaskPriority enum
+ * 
+ * Lane of the pool's queue a task is submitted to. Workers take tasks from
+ * higher lanes first.
+ */
+typedef enum _TaskPriority {
+    PRIORITY_HIGH,   // Latency-critical (interactive) work
+    PRIORITY_NORMAL, // The default
+    PRIORITY_LOW     // Bulk (batch) work
+} TaskPriority;
+
+
+
+/**
+ * ShutdownMode enum
+ * 
+ * What Winpool::shutdown does with the tasks that haven't started.
+ */
+typedef enum _ShutdownMode {
+    SHUTDOWN_DRAIN, // Run them all, and whatever they submit
+    SHUTDOWN_FAST   // Skip the cancellable ones (see CancelToken)
+} ShutdownMode;
+
+/* nPriorities: Number of TaskPriority levels. */
+const int nPriorities = 3;
+
+
+
 /**
  * Future class
  */
 class Future final {
 public:
     
-    /* lock: This protects all memory in this class. This will point to the lock
-             protecting the queue this Future was put on (either pool or worker
-             lock).
-             Lock this everytime you access this Future's memory. */
-    CRITICAL_SECTION *lock;
+    /* nRefs: One reference for the handle submit returned, dropped by get
+              or release, and one for the pool, dropped by the executor once
+              the Future is DONE. Whoever drops the last one deletes the 
+              Future, so completing a task touches no shared list. */
+    std::atomic<uint32_t> nRefs;
     
-    /* status: Use this to determine what stage of execution the future is in. */
-    FutureStatus status;
+    /* status: A FutureStatus telling what stage of execution the future is 
+               in. The executor moves it QUEUED -> RUNNING -> DONE with 
+               release stores; whoever sees DONE with an acquire load can 
+               read res. cancel may move it QUEUED -> CANCELLED first. 
+               Threads blocked in get sleep on this word. */
+    std::atomic<uint32_t> status;
+
+    /* nWaiters: Number of external threads blocked in get, waiting for 
+                 status to become DONE. Completion only wakes status if this
+                 isn't 0. */
+    std::atomic<uint32_t> nWaiters;
 
     /* bPool: Borrowed pointer to the Winpool this Future was submitted to and
               is run on. */
     Winpool *bPool;
     
-    /* func: This functor will be executed. */
-    WinpoolTask func;
-    
-    /* arg: this will be passed to func. */
+    /* arg: Argument the task was submitted with by submit(func, arg). 
+            nullptr for tasks submitted as a callable. */
     void *arg; 
     
-    /* res: Result returned from func. */
+    /* res: Result returned from the task. For tasks with a typed result that
+            isn't a pointer, this points at the result, which lives in 
+            taskStorage (or on the heap if it doesn't fit). */
     void *res; 
     
-    /* owner: Points to the worker whose queue this future was placed on - lock
-              points to owner's lock. */
+    /* owner: Points to the worker whose queue this future was placed on. */
     FutureOwner *owner;
     
-    /* executor: Points to the worker who executed/is executing this task. */
+    /* executor: Points to the worker who executed/is executing this task. 
+                 Set before status becomes RUNNING. */
     Worker *executor;
     
-    /* condCompleted: Condition variable will be broadcasted when the future
-                      is fulfilled and the result is available. Used by 
-                      external threads calling Future.get. */
-    CONDITION_VARIABLE condCompleted;
-    
     /* next: Points to the next element in whatever FutureList this is in. 
              This pointer holds ownership of the Future it points to. */
     UniquePtr<Future> next;
@@ -166,6 +576,54 @@ public:
     /* prev: Borrowing pointer to the previous element in whatever FutureList 
              this is in. */
     Future *prev;
+
+    /* queueNext: Next element in the InjectionShard this is in, or in the
+                 continuations list of the Future this is waiting for. */
+    std::atomic<Future *> queueNext;
+
+    /* continuations: Stack of Futures, linked through queueNext, to submit
+                      once this one is DONE. Set to this Future itself when
+                      it completes: continuations added after that are 
+                      submitted right away. Owns the Futures in it. */
+    std::atomic<Future *> continuations;
+
+    /* detached: Nobody will get this Future. executeFuture deletes it as 
+                 soon as its task returns instead of completing it. */
+    bool detached;
+
+    /* priority: Lane of the pool's queue submitFuture puts this Future in. 
+                 Anything but PRIORITY_NORMAL skips the worker deques. */
+    TaskPriority priority;
+
+    /* cancellable: May the task be skipped instead of run (by cancel, or 
+                    because its token was cancelled)? Only for tasks nothing
+                    else keeps count of: those from submit and then. */
+    bool cancellable;
+
+    /* cancelled: Set before DONE if the task was skipped, or gave up by 
+                  throwing TaskCancelled. There is no result then. */
+    bool cancelled;
+
+    /* token: Cancellation state the task runs under, passed on to the 
+              tasks it submits. nullptr for none. Holds a reference. */
+    CancelState *token;
+
+    /* invokeTask: Type-erased thunk that runs the callable in taskStorage,
+                   destroys it and sets res. A typed result is stored in 
+                   taskStorage in the callable's place, and destroyTask is 
+                   switched over to it. */
+    void (*invokeTask)(Future *fut);
+
+    /* destroyTask: Type-erased thunk that destroys whatever lives in 
+                    taskStorage - the callable before the task runs, the 
+                    typed result after. nullptr if there's nothing to 
+                    destroy. */
+    void (*destroyTask)(Future *fut);
+
+    /* taskStorage: The callable (later the result) itself if it fits in 
+                    taskStorageSize bytes, otherwise a pointer to a heap copy
+                    of it. */
+    alignas(std::max_align_t) unsigned char taskStorage[taskStorageSize];
     
     
     /**
@@ -177,6 +635,16 @@ public:
      * owner: Borrowed pointer to the FutureOwner that protects this Future.
      */
     Future(WinpoolTask func, void *arg, Winpool *bPool, FutureOwner *owner);
+
+    /**
+     * Future task-less constructor
+     * 
+     * Creates a Future with no task and no owner. Give it a task with setTask
+     * and pass it to Winpool::submitFuture.
+     * 
+     * bPool: Borrowed pointer to the pool.
+     */
+    Future(Winpool *bPool);
     
     /** 
      * Future sentinel constructor
@@ -190,6 +658,37 @@ public:
      * Future destructor
      */
     ~Future();
+
+    /**
+     * Future operator new
+     * 
+     * Allocates Futures from the calling worker's FutureSlab, or from the 
+     * global heap on external threads.
+     */
+    static void *operator new(size_t size);
+
+    /**
+     * Future operator delete
+     * 
+     * Returns a Future's memory to wherever it was allocated from. Safe to 
+     * call on any thread.
+     */
+    static void operator delete(void *ptr);
+
+    /**
+     * Future::setTask
+     * 
+     * Moves a callable into this Future as its task (lvalues are copied). 
+     * Callables of up to taskStorageSize bytes are stored inline, so this 
+     * doesn't allocate; bigger ones are moved to the heap. Only call this 
+     * once, before the Future is submitted.
+     * 
+     * func: Callable taking no arguments. Pointer results (and void) are 
+     *       kept in res, anything else is stored in the Future - see 
+     *       TypedFuture::get.
+     */
+    template<class F>
+    void setTask(F &&func);
     
     /**
      * Future::get
@@ -200,13 +699,91 @@ public:
      * 
      * newOwner: If not nullptr, a UniquePtr holding ownership of this Future
      *           will be placed at newOwner.
-     *           If nullptr, this Future will be discarded after this call 
-     *           returns.
+     *           If nullptr, the handle's reference is dropped and this 
+     *           Future will be discarded once the pool is done with it.
      * 
      * Return Value: Returns the result returned by this Future's task.
      */
     void *get(UniquePtr<Future> *newOwner);
 
+    /**
+     * Future::join
+     * 
+     * Waits until this Future is DONE, like get, but keeps the handle's 
+     * reference: call release once done with the result.
+     * 
+     * Return Value: Returns the result returned by this Future's task.
+     */
+    void *join();
+
+    /**
+     * Future::cancel
+     * 
+     * Stops a cancellable task that hasn't started from ever running. Its 
+     * Future still completes (as cancelled) when the task would have run:
+     * queues can't unlink it from the middle, so whoever pops it skips it.
+     * 
+     * Return Value: Returns true if the task was cancellable and QUEUED.
+     */
+    bool cancel();
+
+    /**
+     * Future::tryGet
+     * 
+     * Like get(nullptr) if this Future is DONE; otherwise returns right 
+     * away, keeping the handle. Never blocks or takes a lock.
+     * 
+     * res: Where to put the result returned by the task.
+     * 
+     * Return Value: Returns true if the task was done and res was set.
+     */
+    bool tryGet(void **res);
+
+    /**
+     * Future::waitUntil
+     * 
+     * Blocks the calling thread until this Future is DONE or deadlineNs 
+     * has passed, whichever comes first. Keeps the handle either way. Once 
+     * the deadline has passed this is a load and a clock read: cheap 
+     * enough to poll. Unlike get, a worker thread doesn't help with other
+     * tasks meanwhile, so keep waits short there.
+     * 
+     * deadlineNs: Time to give up at, on the monotonicNs clock.
+     * 
+     * Return Value: Returns true if this Future is DONE.
+     */
+    bool waitUntil(uint64_t deadlineNs);
+
+    /**
+     * Future::waitFor
+     * 
+     * Like waitUntil, giving up after timeoutNs nanoseconds.
+     * 
+     * timeoutNs: Longest time to wait for.
+     * 
+     * Return Value: Returns true if this Future is DONE.
+     */
+    bool waitFor(uint64_t timeoutNs);
+
+    /**
+     * Future::release
+     * 
+     * Drops a reference, deleting this Future after the last one. Call it 
+     * instead of get to give up on a result; the task still runs.
+     */
+    void release();
+
+    /**
+     * Future::addContinuation
+     * 
+     * Submits cont to its pool once this Future is DONE - right away if it
+     * already is. Nobody blocks in the meantime.
+     * 
+     * cont: Future with its task set, with ownership passed to this 
+     *       function.
+     */
+    void addContinuation(UniquePtr<Future> cont);
+
     /**
      * Future::removeFromList
      * 
@@ -302,108 +879,1787 @@ public:
 
 
 /**
- * Worker class
+ * FutureDequeBuffer class
+ * 
+ * Circular array backing a FutureDeque. When a deque outgrows its buffer it
+ * switches to a buffer twice the size; the old one is kept alive (chained 
+ * through retired) until the deque is destroyed because thieves may still be
+ * reading from it.
  */
-class Worker final {
+class FutureDequeBuffer final {
 public:
 
-    /* lock: Protects all members of this class, its queues, and all 
-             Futures originally inserted into our queue. */
-    CRITICAL_SECTION lock;
+    /* capacity: Number of slots. Always a power of 2. */
+    int64_t capacity;
 
-    /* taskQueue: Linked list that contains subtasks of tasks we're executing
-                  that need to be executed. */
-    FutureList taskQueue;
+    /* slots: The circular array. Index i lives at slots[i & (capacity - 1)]. */
+    UniquePtr<std::atomic<Future *>[]> slots;
+
+    /* retired: The buffer this one replaced, or nullptr. */
+    UniquePtr<FutureDequeBuffer> retired;
 
-    /* completedList: Linked list that just holds ownership of completed 
-                      Futures we own until the user takes ownership with 
-                      Future::get. */
-    FutureList completedList;
 
     /**
-     * Worker constructor
+     * FutureDequeBuffer constructor
      * 
-     * Initializes this instance with an empty taskQueue and completedList.
+     * capacity: Number of slots, must be a power of 2.
      */
-    Worker();
+    FutureDequeBuffer(int64_t capacity);
 };
 
 
 
 /**
- * Winpool class
+ * FutureDeque class
+ * 
+ * Lock-free work-stealing deque of Futures (Chase-Lev). The worker that owns
+ * the deque pushes and pops at the bottom, any other thread steals from the 
+ * top. push never performs an atomic read-modify-write; pop only does when
+ * it races a thief for the last element.
+ * 
+ * The deque holds ownership of the Futures in it.
  */
-class Winpool final {
+class FutureDeque final {
 public:
 
-    /* futures: Pool queue of tasks and list holding ownership of completed 
-                tasks. */
-    FutureOwner futures;
-
-    /* nWorkers: The number of worker threads. This is the size of the 
-                 hWorkerThreads and the workers array. */
-    int nWorkers;
-
-    /* workerIdTlsIdx: Tls index of the thread-local worker object. 
-                       This will be nullptr in external threads. */
-    DWORD workerTlsIdx;
-
-    /* lock: This protects all data in this class and the pool's task queue.
-             Note: This will point to this->futures.lock. */
-    CRITICAL_SECTION *lock;
+    /* top: Index of the oldest element. Thieves advance it with a CAS. */
+    alignas(64) std::atomic<int64_t> top;
 
-    /* hWorkerThreads: Points to a heap-allocated array of the worker threads'
-                       HANDLEs. */
-    UniquePtr<HANDLE[]> hWorkerThreads;
+    /* bottom: Index one past the newest element. Only the owner writes it. */
+    alignas(64) std::atomic<int64_t> bottom;
 
-    /* workers: Points to heap-allocated array of Worker instances. Each worker
-                contains data needed for a worker thread. */
-    UniquePtr<Worker[]> workers;
+    /* buffer: The current circular array. Only the owner replaces it. */
+    std::atomic<FutureDequeBuffer *> buffer;
 
-    /* workerDatas: Points to heap-allocated array of Worker instances */
-    UniquePtr<WorkerTProcData[]> workerDatas;
 
-    bool running;
+    /**
+     * FutureDeque constructor
+     * 
+     * Creates an empty deque.
+     */
+    FutureDeque();
 
+    /**
+     * FutureDeque destructor
+     * 
+     * On destruction, all Futures still in the deque will be deleted.
+     */
+    ~FutureDeque();
 
     /**
-     * Winpool::createNew
+     * FutureDeque::push
      * 
-     * Creates and initializes a Winpool instance on the heap, starts up the 
-     * worker threads, passes ownership of this instance to the caller.
+     * Inserts a Future at the bottom of the deque. Owner only.
      * 
-     * nThreads: Number of worker threads to spawn.
+     * toPush: Pointer to the Future to insert with ownership passed to this
+     *         function.
+     */
+    void push(UniquePtr<Future> toPush);
+
+    /**
+     * FutureDeque::pop
      * 
-     * Return Value: Returns a pointer to the newly created Winpool instance
-     *               that holds ownership of it.
+     * Removes and returns the newest Future (bottom). Owner only.
+     * 
+     * Return Value: Returns a pointer to the popped Future that owns its 
+     *               memory. Returns nullptr if the deque is empty.
      */
-    static UniquePtr<Winpool> createNew(int nThreads);
+    UniquePtr<Future> pop();
 
+    /**
+     * FutureDeque::steal
+     * 
+     * Removes and returns the oldest Future (top). Any thread may call this.
+     * 
+     * Return Value: Returns a pointer to the stolen Future that owns its 
+     *               memory. Returns nullptr if the deque is empty or another
+     *               thread took the element first.
+     */
+    UniquePtr<Future> steal();
 
     /**
-     * Winpool::submit
+     * FutureDeque::empty
      * 
-     * Adds a task to the pool's task queue. Once this is called, the pool may
-     * start executing the task immediately.
+     * Is there anything in the deque? Only a snapshot when called by anyone
+     * other than the owner.
      * 
-     * func: Function to execute.
-     * arg: Argument to pass to func.
+     * Return Value: Returns true if the deque looked empty.
+     */
+    bool empty();
+
+    /**
+     * FutureDeque::size
      * 
-     * Return Value: Returns a pointer to a heap-allocated Future which can
-     *               be used to obtain the task's result in the future.
-     *               The caller does NOT own this memory - do NOT delete: 
-     *               ownership of this memory is held by the pool until 
-     *               completion.
+     * How many Futures are in the deque? Reads two words without locking, so
+     * it's cheap enough for thieves to use as a load hint when picking a 
+     * victim - but only a snapshot when called by anyone other than the owner.
+     * 
+     * Return Value: Returns the number of Futures the deque looked like it 
+     *               held.
      */
-    Future *submit(WinpoolTask func, void *arg);
+    int64_t size();
 
     /**
-     * Winpool::shutdown
+     * FutureDeque::pushBatch
+     * 
+     * Inserts all of a FutureBatch's Futures at the bottom of the deque, in
+     * order, publishing them with a single store. Owner only.
+     * 
+     * batch: Batch whose Futures to insert. Ownership of the Futures is 
+     *        passed to the deque.
      */
-    bool shutdown();
+    void pushBatch(FutureBatch *batch);
 };
 
-} // end WinpoolNS
+
+
+/**
+ * InjectionShard class
+ * 
+ * Unbounded lock-free queue of Futures (Vyukov's intrusive MPSC queue): any
+ * number of threads push with a single exchange, one thread at a time pops.
+ * Consumers take turns through consumerBusy, a try-lock that is never 
+ * waited on.
+ * 
+ * The shard holds ownership of the Futures in it.
+ */
+class InjectionShard final {
+public:
+
+    /* head: The newest element. Producers swap themselves in here. */
+    alignas(64) std::atomic<Future *> head;
+
+    /* consumerBusy: Set while a consumer is popping. */
+    alignas(64) std::atomic<bool> consumerBusy;
+
+    /* tail: The oldest element (or stub). Only touched by the consumer 
+             holding consumerBusy. */
+    Future *tail;
+
+    /* stub: Dummy element that keeps the queue from ever being truly empty. */
+    Future stub;
+
+
+    /**
+     * InjectionShard constructor
+     * 
+     * Creates an empty shard.
+     */
+    InjectionShard();
+
+    /**
+     * InjectionShard destructor
+     * 
+     * On destruction, all Futures still in the shard will be deleted.
+     */
+    ~InjectionShard();
+
+    InjectionShard(const InjectionShard &) = delete;
+    InjectionShard &operator=(const InjectionShard &) = delete;
+
+    /**
+     * InjectionShard::push
+     * 
+     * Inserts a Future at the head. Any thread may call this.
+     * 
+     * toPush: Future to insert, with ownership passed to the shard.
+     */
+    void push(Future *toPush);
+
+    /**
+     * InjectionShard::pushChain
+     * 
+     * Inserts a chain of Futures, already linked from first to last through
+     * queueNext, with a single exchange. Any thread may call this.
+     * 
+     * first: Oldest Future of the chain.
+     * last: Newest Future of the chain. Ownership of the whole chain is 
+     *       passed to the shard.
+     */
+    void pushChain(Future *first, Future *last);
+
+    /**
+     * InjectionShard::tryPop
+     * 
+     * Removes the oldest Future if no other consumer is popping from this 
+     * shard right now. Any thread may call this.
+     * 
+     * Return Value: Returns the popped Future with ownership passed to the 
+     *               caller. Returns nullptr if the shard is empty, busy, or
+     *               a producer is half-way through pushing the only 
+     *               element.
+     */
+    Future *tryPop();
+};
+
+
+
+/**
+ * InjectionQueue class
+ * 
+ * Queue of tasks submitted by external threads, with one lane per 
+ * TaskPriority. Producers are spread over several InjectionShards per lane
+ * so they don't all fight over one cache line; consumers (workers) scan 
+ * the shards from a random start and skip shards another worker is 
+ * popping from. Nothing takes a lock.
+ * 
+ * Higher lanes are served first, except that now and then (see 
+ * agingPeriod) a lower lane goes first so it can't starve.
+ * 
+ * Tasks from one producer thread at one priority come out in the order 
+ * they went in.
+ */
+class InjectionQueue final {
+public:
+
+    /* tlsProducerId: Calling thread's producer number, 0 until it first 
+                      pushes. Picks the thread's shard. */
+    static thread_local uint32_t tlsProducerId;
+
+    /* nextProducerId: Next producer number to hand out. */
+    static std::atomic<uint32_t> nextProducerId;
+
+    /* nShards: Number of shards per lane. */
+    int nShards;
+
+    /* shards: Heap-allocated array of nPriorities * nShards shards, lane 
+               after lane. */
+    UniquePtr<InjectionShard[]> shards;
+
+
+    /**
+     * InjectionQueue constructor
+     * 
+     * Creates an empty queue.
+     */
+    InjectionQueue();
+
+    /**
+     * InjectionQueue::push
+     * 
+     * Inserts a Future into the calling thread's shard of the Future's 
+     * priority lane. Any thread may call this.
+     * 
+     * toPush: Pointer to the Future to insert with ownership passed to this
+     *         function.
+     */
+    void push(UniquePtr<Future> toPush);
+
+    /**
+     * InjectionQueue::pushChain
+     * 
+     * Inserts a chain of Futures, already linked from first to last through
+     * queueNext, into the calling thread's shard with a single exchange. 
+     * The chain goes into first's priority lane. Any thread may call this.
+     * 
+     * first: Oldest Future of the chain.
+     * last: Newest Future of the chain. Ownership of the whole chain is 
+     *       passed to the queue.
+     */
+    void pushChain(Future *first, Future *last);
+
+    /**
+     * InjectionQueue::pop
+     * 
+     * Removes a Future from the highest lane that has one (or a lower lane 
+     * being aged), from the first shard, starting at start, that has one 
+     * and isn't busy. Any thread may call this.
+     * 
+     * start: Where to start scanning (taken modulo nShards). Pass something
+     *        random so consumers spread out: its high bits also pick the 
+     *        pops that age lower lanes.
+     * 
+     * Return Value: Returns a pointer to the popped Future that owns its 
+     *               memory. Returns nullptr if nothing could be popped.
+     */
+    UniquePtr<Future> pop(uint64_t start);
+
+    /**
+     * InjectionQueue::empty
+     * 
+     * Return Value: Returns true if no lane of any shard has a Future. Only
+     *               a hint while other threads push or pop.
+     */
+    bool empty();
+};
+
+
+
+/**
+ * EventCount class
+ * 
+ * Lets idle workers sleep until new work shows up without making the 
+ * submitting side pay for a syscall unless somebody is actually asleep.
+ * 
+ * Waiter protocol: key = prepareWait(), re-check for work, then either 
+ * cancelWait() if work was found or wait(key). Notifiers publish the work 
+ * first and then call notifyOne/notifyAll.
+ */
+class EventCount final {
+public:
+
+    /* epoch: Bumped by every notify that finds a waiter. Waiters sleep on 
+              this word. */
+    std::atomic<uint32_t> epoch;
+
+    /* nWaiters: Number of threads between prepareWait and the end of wait or
+                 cancelWait. */
+    std::atomic<uint32_t> nWaiters;
+
+
+    /**
+     * EventCount constructor
+     */
+    EventCount();
+
+    EventCount(const EventCount &) = delete;
+    EventCount &operator=(const EventCount &) = delete;
+
+    /**
+     * EventCount::prepareWait
+     * 
+     * Registers the calling thread as a waiter. The caller must check for 
+     * work again after this and then call wait or cancelWait.
+     * 
+     * Return Value: Returns the key to pass to wait.
+     */
+    uint32_t prepareWait();
+
+    /**
+     * EventCount::cancelWait
+     * 
+     * Unregisters a waiter that found work after prepareWait.
+     */
+    void cancelWait();
+
+    /**
+     * EventCount::wait
+     * 
+     * Sleeps until a notify happens after the prepareWait that returned key,
+     * then unregisters the waiter. Returns immediately if one already did.
+     * 
+     * key: Value returned by prepareWait.
+     */
+    void wait(uint32_t key);
+
+    /**
+     * EventCount::waitFor
+     * 
+     * Like wait, but gives up once timeoutNs nanoseconds have passed.
+     * 
+     * key: Value returned by prepareWait.
+     * timeoutNs: Longest time to sleep for.
+     */
+    void waitFor(uint32_t key, uint64_t timeoutNs);
+
+    /**
+     * EventCount::notifyOne
+     * 
+     * Wakes up one waiter, if there are any. Costs no syscall and no atomic
+     * read-modify-write when nobody is waiting.
+     */
+    void notifyOne();
+
+    /**
+     * EventCount::notifyAll
+     * 
+     * Wakes up all waiters.
+     */
+    void notifyAll();
+
+    /**
+     * EventCount::notifyMany
+     * 
+     * Wakes up to n waiters. Like notifyOne, costs nothing when nobody is 
+     * waiting.
+     * 
+     * n: Number of waiters to wake.
+     */
+    void notifyMany(uint32_t n);
+};
+
+
+
+/**
+ * FutureBatch class
+ * 
+ * One allocation holding everything a submitBatch needs: this header, the 
+ * callable all of the batch's tasks share, and one Future block per task.
+ * Batch Futures are detached; each task counts itself off nPending when it
+ * finishes, and FutureBatch::join waits for that count to reach 0. A 
+ * TaskGraph keeps one batch for all its runs.
+ */
+class FutureBatch final {
+public:
+
+    /* bPool: Borrowed pointer to the pool the batch was submitted to. */
+    Winpool *bPool;
+
+    /* nTasks: Number of tasks (and Future blocks) in the batch. */
+    uint32_t nTasks;
+
+    /* nRefs: One reference per Future in the batch that hasn't been deleted
+              yet, plus one for the TaskBatch handle. Whoever drops it to 0 
+              frees the allocation. */
+    std::atomic<int64_t> nRefs;
+
+    /* nPending: Number of tasks that haven't finished yet. Joiners sleep on
+                 this word. */
+    std::atomic<uint32_t> nPending;
+
+    /* nWaiters: Number of threads blocked in FutureBatch::join. The last 
+                 task only wakes nPending if this isn't 0. */
+    std::atomic<uint32_t> nWaiters;
+
+    /* funcStorage: The tasks' shared callable. */
+    void *funcStorage;
+
+    /* destroyFunc: Type-erased thunk that destroys the callable in 
+                    funcStorage, nullptr until one is put there. */
+    void (*destroyFunc)(void *func);
+
+    /* futureBlocks: nTasks blocks of futureBlockSize bytes. */
+    char *futureBlocks;
+
+
+    /**
+     * FutureBatch::create
+     * 
+     * Allocates a batch with room for nTasks Futures and a funcSize byte
+     * (64 byte aligned) callable.
+     * 
+     * bPool: Borrowed pointer to the pool the batch will be submitted to.
+     * nTasks: Number of tasks in the batch.
+     * funcSize: Size of the callable the tasks share.
+     * 
+     * Return Value: Returns a borrowed pointer to the new batch, which frees
+     *               itself once its Futures and the TaskBatch handle are gone.
+     */
+    static FutureBatch *create(Winpool *bPool, 
+                               uint32_t nTasks, 
+                               size_t funcSize);
+
+    /**
+     * FutureBatch::newFuture
+     * 
+     * Constructs the iTask-th Future of the batch in its block, with no task
+     * yet.
+     * 
+     * Return Value: Returns a pointer to the Future. It is owned by whoever 
+     *               it is handed to like any other Future.
+     */
+    Future *newFuture(uint32_t iTask);
+
+    /**
+     * FutureBatch::futureAt
+     * 
+     * Return Value: Returns a pointer to the iTask-th Future of the batch.
+     */
+    Future *futureAt(uint32_t iTask);
+
+    /**
+     * FutureBatch::finishTask
+     * 
+     * Called by each task once it has run. Wakes up joiners after the last 
+     * one.
+     */
+    void finishTask();
+
+    /**
+     * FutureBatch::join
+     * 
+     * Waits until nPending reaches 0. Worker threads run other tasks 
+     * meanwhile, external threads sleep.
+     */
+    void join();
+
+    /**
+     * FutureBatch::release
+     * 
+     * Drops a reference, freeing the batch after the last one.
+     */
+    void release();
+};
+
+
+
+/**
+ * TaskBatch class
+ * 
+ * Handle returned by Winpool::submitBatch for joining the whole batch. 
+ * Dropping it without joining is fine - the tasks still run.
+ */
+class TaskBatch final {
+public:
+
+    /* batch: The batch. The handle holds one reference to it. nullptr once 
+              moved from. */
+    FutureBatch *batch;
+
+
+    /**
+     * TaskBatch constructor
+     * 
+     * batch: Batch to hold, with the caller's reference passed to the 
+     *        handle.
+     */
+    TaskBatch(FutureBatch *batch);
+
+    /**
+     * TaskBatch move constructor
+     */
+    TaskBatch(TaskBatch &&other);
+
+    /**
+     * TaskBatch destructor
+     * 
+     * Drops the handle's reference without waiting for the tasks.
+     */
+    ~TaskBatch();
+
+    TaskBatch(const TaskBatch &) = delete;
+    TaskBatch &operator=(const TaskBatch &) = delete;
+
+    /**
+     * TaskBatch::done
+     * 
+     * Return Value: Returns true if every task in the batch has finished.
+     */
+    bool done();
+
+    /**
+     * TaskBatch::join
+     * 
+     * Waits until every task in the batch has finished. Worker threads run
+     * other tasks meanwhile, external threads sleep.
+     */
+    void join();
+};
+
+
+
+/**
+ * TaskGroup class
+ * 
+ * Structured fork-join: run() spawns children of the calling task into 
+ * the pool (onto the worker's own deque) and wait() joins all of them at 
+ * once through a single pending counter instead of one Future per child.
+ * Children may run() more children into the same group. The group must 
+ * outlive its children, so the destructor waits for them.
+ */
+class TaskGroup final {
+public:
+
+    /* waiterBit: Set in state while an external thread sleeps in wait. */
+    static const uint32_t waiterBit = 1u << 31;
+
+    /* bPool: Borrowed pointer to the pool children are spawned into. */
+    Winpool *bPool;
+
+    /* state: Number of children that haven't finished yet, ORed with 
+              waiterBit. Kept in one word so a finishing child never has to
+              touch the group after its decrement - the group may be gone by
+              then. External waiters sleep on this word. */
+    std::atomic<uint32_t> state;
+
+
+    /**
+     * TaskGroup constructor
+     * 
+     * bPool: Pool to spawn children into.
+     */
+    TaskGroup(Winpool *bPool);
+
+    /**
+     * TaskGroup destructor
+     * 
+     * Waits for every child that is still running.
+     */
+    ~TaskGroup();
+
+    TaskGroup(const TaskGroup &) = delete;
+    TaskGroup &operator=(const TaskGroup &) = delete;
+
+    /**
+     * TaskGroup::run
+     * 
+     * Spawns a child calling func(args...) into the group. Its result is 
+     * discarded.
+     * 
+     * func: Callable to execute.
+     * args: Arguments to pass to func.
+     */
+    template<class F, class... Args>
+    void run(F &&func, Args &&...args);
+
+    /**
+     * TaskGroup::finishTask
+     * 
+     * Called by each child once it has run. Wakes up external waiters 
+     * after the last one.
+     */
+    void finishTask();
+
+    /**
+     * TaskGroup::done
+     * 
+     * Return Value: Returns true if every child run so far has finished.
+     */
+    bool done();
+
+    /**
+     * TaskGroup::wait
+     * 
+     * Waits until every child run so far has finished. Worker threads run 
+     * other tasks meanwhile - the children first, since they're on top of
+     * their own deque. External threads sleep.
+     */
+    void wait();
+};
+
+
+
+/**
+ * TaskGraph class
+ * 
+ * A dependency graph of tasks declared once and launched over and over.
+ * Every run reuses the same node Futures (one FutureBatch kept for the 
+ * graph's lifetime) and releases a node by counting down its precomputed
+ * in-degree as its dependencies finish, so a run allocates nothing and 
+ * nothing blocks on a Future. Runs don't overlap: launch waits for the 
+ * previous one first.
+ */
+class TaskGraph final {
+public:
+
+    /* bPool: Borrowed pointer to the pool runs are submitted to. */
+    Winpool *bPool;
+
+    /* tasks: Each node's callable. */
+    std::vector<GraphTask> tasks;
+
+    /* successors: For each node, the nodes that depend on it. */
+    std::vector<std::vector<uint32_t>> successors;
+
+    /* inDegrees: For each node, the number of nodes it depends on. */
+    std::vector<uint32_t> inDegrees;
+
+    /* roots: The nodes that depend on nothing, submitted by launch. */
+    std::vector<uint32_t> roots;
+
+    /* nPendingDeps: For each node, the dependencies that haven't finished 
+                     yet this run. Whoever drops it to 0 submits the node. */
+    UniquePtr<std::atomic<uint32_t>[]> nPendingDeps;
+
+    /* batch: Holds the nodes' Futures, with one reference for the graph. 
+              nullptr until the graph is built. */
+    FutureBatch *batch;
+
+    /* built: Are roots, nPendingDeps and batch up to date with the nodes 
+              and edges? */
+    bool built;
+
+
+    /**
+     * TaskGraph constructor
+     * 
+     * bPool: Pool to run the graph on.
+     */
+    TaskGraph(Winpool *bPool);
+
+    /**
+     * TaskGraph destructor
+     * 
+     * Waits for the current run, if any.
+     */
+    ~TaskGraph();
+
+    TaskGraph(const TaskGraph &) = delete;
+    TaskGraph &operator=(const TaskGraph &) = delete;
+
+    /**
+     * TaskGraph::addNode
+     * 
+     * Adds a node running task. Don't call this during a run.
+     * 
+     * task: Callable to run once per launch.
+     * 
+     * Return Value: Returns the node's index, to pass to addEdge.
+     */
+    uint32_t addNode(GraphTask task);
+
+    /**
+     * TaskGraph::addEdge
+     * 
+     * Makes node iTo wait for node iFrom in every run. Don't call this 
+     * during a run. The graph must stay acyclic.
+     * 
+     * iFrom: Index of the node that runs first.
+     * iTo: Index of the node that depends on it.
+     */
+    void addEdge(uint32_t iFrom, uint32_t iTo);
+
+    /**
+     * TaskGraph::build
+     * 
+     * Works out the roots and sets up the node Futures' batch after nodes 
+     * or edges changed. launch calls this when needed.
+     */
+    void build();
+
+    /**
+     * TaskGraph::launch
+     * 
+     * Starts a run of the whole graph and returns without waiting for it 
+     * (after waiting for the previous run).
+     */
+    void launch();
+
+    /**
+     * TaskGraph::wait
+     * 
+     * Waits until the current run has finished. Worker threads run other 
+     * tasks meanwhile, external threads sleep.
+     */
+    void wait();
+
+    /**
+     * TaskGraph::runNode
+     * 
+     * Task of node iNode's Future: runs the node, then every dependent it 
+     * was the last dependency of - one right here, the rest submitted.
+     * 
+     * iNode: Index of the node.
+     */
+    void runNode(uint32_t iNode);
+};
+
+
+
+/**
+ * WorkerState enum
+ */
+typedef enum _WorkerState {
+    WORKER_UNSTARTED, // The slot has no thread yet
+    WORKER_ACTIVE,
+    WORKER_PARKED     // Retired until the pool needs the worker again
+} WorkerState;
+
+
+
+/**
+ * BlockingRegion class
+ * 
+ * Announces that the calling task is about to block (in a syscall, an 
+ * external wait...) for as long as the object lives. While a worker is 
+ * inside one, the pool runs an extra worker in its place, then retires it
+ * once the region ends. Does nothing on threads that aren't workers of 
+ * the pool. Regions may nest.
+ */
+class BlockingRegion final {
+public:
+
+    /* bPool: Borrowed pointer to the pool. */
+    Winpool *bPool;
+
+    /* counted: Did entering the region count the calling worker as 
+                blocked? */
+    bool counted;
+
+
+    /**
+     * BlockingRegion constructor
+     * 
+     * bPool: Pool whose worker may be running the calling task.
+     */
+    BlockingRegion(Winpool *bPool);
+
+    /**
+     * BlockingRegion destructor
+     * 
+     * Ends the region. Call it on the thread that created it.
+     */
+    ~BlockingRegion();
+
+    BlockingRegion(const BlockingRegion &) = delete;
+    BlockingRegion &operator=(const BlockingRegion &) = delete;
+};
+
+
+
+/**
+ * CancelState class
+ * 
+ * Shared state behind CancelTokens, reference counted.
+ */
+class CancelState final {
+public:
+
+    /* nRefs: One reference per CancelToken and per Future holding this. */
+    std::atomic<uint32_t> nRefs;
+
+    /* cancelled: Set once by CancelToken::cancel, never cleared. */
+    std::atomic<bool> cancelled;
+
+
+    /**
+     * CancelState constructor
+     * 
+     * Creates an uncancelled state with one reference.
+     */
+    CancelState();
+
+    CancelState(const CancelState &) = delete;
+    CancelState &operator=(const CancelState &) = delete;
+
+    /**
+     * CancelState::addRef
+     * 
+     * Takes another reference.
+     */
+    void addRef();
+
+    /**
+     * CancelState::release
+     * 
+     * Drops one reference, deleting the state if it was the last one.
+     */
+    void release();
+};
+
+
+
+/**
+ * CancelToken class
+ * 
+ * Cooperative cancellation for a tree of tasks. A task submitted with a 
+ * token runs under it, and so does everything it submits or spawns (and 
+ * their continuations), recursively. Once the token is cancelled, tasks 
+ * of the tree that haven't started yet are skipped - only those from 
+ * submit and then, whose Futures complete as cancelled - and running ones
+ * can see it through Winpool::cancelRequested and stop early. Copies share
+ * the same state.
+ */
+class CancelToken final {
+public:
+
+    /* state: The shared state, with one reference held by this token. */
+    CancelState *state;
+
+
+    /**
+     * CancelToken constructor
+     * 
+     * Creates a new, uncancelled token.
+     */
+    CancelToken();
+
+    /**
+     * CancelToken copy constructor
+     * 
+     * Makes another handle to the same token.
+     */
+    CancelToken(const CancelToken &other);
+
+    /**
+     * CancelToken copy assignment
+     * 
+     * Lets go of this handle's token and shares other's.
+     */
+    CancelToken &operator=(const CancelToken &other);
+
+    /**
+     * CancelToken destructor
+     */
+    ~CancelToken();
+
+    /**
+     * CancelToken::cancel
+     * 
+     * Cancels the token. Any thread may call this, any number of times.
+     */
+    void cancel();
+
+    /**
+     * CancelToken::cancelled
+     * 
+     * Return Value: Returns true once the token has been cancelled.
+     */
+    bool cancelled() const;
+};
+
+
+
+/**
+ * Timer class
+ * 
+ * A task scheduled with Winpool::submitAfter or submitEvery. While armed, 
+ * it sits in one slot of its pool's TimerWheel; each time it fires, its 
+ * task is spawned into the pool.
+ */
+class Timer final {
+public:
+
+    /* nRefs: One reference for the TimerHandle, one for the wheel while the
+              timer is armed, and one for each firing whose task hasn't 
+              returned yet. Whoever drops the last one deletes the timer. */
+    std::atomic<uint32_t> nRefs;
+
+    /* bPool: Borrowed pointer to the pool the timer's task runs on. */
+    Winpool *bPool;
+
+    /* task: Callable run every time the timer fires. Runs of a periodic 
+             timer may overlap if one takes longer than the period. */
+    TimerTask task;
+
+    /* deadlineTick: Tick (monotonicNs() / timerTickNs) the timer fires at 
+                     next. */
+    uint64_t deadlineTick;
+
+    /* periodTicks: Ticks between firings, 0 for a one-shot timer. */
+    uint64_t periodTicks;
+
+    /* iSlot: Level * timerWheelSlots + slot of the wheel slot the timer is 
+              in, -1 if it isn't armed. */
+    int iSlot;
+
+    /* prev: Previous timer in the same wheel slot. */
+    Timer *prev;
+
+    /* next: Next timer in the same wheel slot. */
+    Timer *next;
+
+    /* fireNext: Next timer in the chain TimerWheel::advance returns. */
+    Timer *fireNext;
+
+
+    /**
+     * Timer constructor
+     * 
+     * Creates a timer that isn't armed yet, with one reference for the 
+     * TimerHandle and one for the wheel.
+     * 
+     * bPool: Pool to run task on.
+     * task: Callable to run when the timer fires.
+     * periodTicks: Ticks between firings, 0 for a one-shot timer.
+     */
+    Timer(Winpool *bPool, TimerTask task, uint64_t periodTicks);
+
+    Timer(const Timer &) = delete;
+    Timer &operator=(const Timer &) = delete;
+
+    /**
+     * Timer::release
+     * 
+     * Drops one reference, deleting the timer if it was the last one.
+     */
+    void release();
+};
+
+
+
+/**
+ * TimerWheel class
+ * 
+ * Hierarchical timer wheel holding a pool's armed Timers. Slot s of level L
+ * holds the timers due in the s-th block of timerWheelSlots^L ticks within
+ * the current block of timerWheelSlots^(L + 1) ticks, so arming or 
+ * cancelling a timer is just linking it into or out of one slot. When a 
+ * level's block starts, its slot is cascaded down into the levels below.
+ * 
+ * Workers advance the wheel between tasks once dueNs has passed; an idle 
+ * pool keeps one worker sleeping until then (see keeperWakeNs). Everything
+ * but busy, dueNs and keeperWakeNs is protected by lock.
+ */
+class TimerWheel final {
+public:
+
+    /* lock: Protects the wheel. */
+    Lock lock;
+
+    /* busy: Set while a worker is advancing the wheel, so the others don't
+             queue up on lock to do the same. */
+    std::atomic<bool> busy;
+
+    /* dueNs: monotonicNs() time the wheel next needs advancing at, 
+              UINT64_MAX if it holds no timers. */
+    std::atomic<uint64_t> dueNs;
+
+    /* keeperWakeNs: Time at which an idle worker sleeping with a timeout 
+                     will wake up to advance the wheel, UINT64_MAX if no 
+                     worker is. Arming a timer due earlier than this wakes 
+                     up an idle worker to take over. */
+    std::atomic<uint64_t> keeperWakeNs;
+
+    /* curTick: Ticks before this one have been processed. */
+    uint64_t curTick;
+
+    /* nTimers: Number of armed timers. */
+    uint64_t nTimers;
+
+    /* occupied: Bit s of occupied[L] is set if slots[L][s] isn't empty. */
+    uint64_t occupied[timerWheelLevels];
+
+    /* slots: Lists of armed timers, linked through Timer::prev/next. Each 
+              list holds its timers' wheel references. */
+    Timer *slots[timerWheelLevels][timerWheelSlots];
+
+
+    /**
+     * TimerWheel constructor
+     * 
+     * Creates an empty wheel starting at the current tick.
+     */
+    TimerWheel();
+
+    /**
+     * TimerWheel destructor
+     * 
+     * Disarms the timers still in the wheel, without firing them.
+     */
+    ~TimerWheel();
+
+    TimerWheel(const TimerWheel &) = delete;
+    TimerWheel &operator=(const TimerWheel &) = delete;
+
+    /**
+     * TimerWheel::insert
+     * 
+     * Arms a timer for its deadlineTick (or curTick, if that has passed). 
+     * Call it with lock held.
+     * 
+     * timer: Timer to arm, with its wheel reference passed to the wheel.
+     */
+    void insert(Timer *timer);
+
+    /**
+     * TimerWheel::remove
+     * 
+     * Unlinks an armed timer from its slot. The caller takes over the 
+     * timer's wheel reference. Call it with lock held.
+     * 
+     * timer: Armed timer to unlink.
+     */
+    void remove(Timer *timer);
+
+    /**
+     * TimerWheel::nextDueTick
+     * 
+     * Call it with lock held.
+     * 
+     * Return Value: Returns the first tick from curTick on at which a timer
+     *               fires or a slot holding timers must be cascaded, 
+     *               UINT64_MAX if the wheel is empty.
+     */
+    uint64_t nextDueTick();
+
+    /**
+     * TimerWheel::advance
+     * 
+     * Processes every tick up to and including nowTick: cascades slots, 
+     * disarms one-shot timers that fire and re-arms periodic ones, then 
+     * updates dueNs. Call it with lock held.
+     * 
+     * nowTick: Current tick.
+     * 
+     * Return Value: Returns the timers that fired, chained through 
+     *               fireNext, each with a reference for its firing.
+     */
+    Timer *advance(uint64_t nowTick);
+
+    /**
+     * TimerWheel::updateDue
+     * 
+     * Sets dueNs from nextDueTick. Call it with lock held.
+     */
+    void updateDue();
+
+    /**
+     * TimerWheel::clear
+     * 
+     * Disarms every timer in the wheel, without firing them. Call it with 
+     * lock held.
+     */
+    void clear();
+};
+
+
+
+/**
+ * TimerHandle class
+ * 
+ * Handle returned by Winpool::submitAfter and submitEvery for cancelling
+ * the timer. Dropping it doesn't cancel anything.
+ */
+class TimerHandle final {
+public:
+
+    /* timer: The timer. The handle holds one reference to it. nullptr once
+              moved from. */
+    Timer *timer;
+
+
+    /**
+     * TimerHandle constructor
+     * 
+     * timer: Timer to hold, with the caller's reference passed to the 
+     *        handle.
+     */
+    TimerHandle(Timer *timer);
+
+    /**
+     * TimerHandle move constructor
+     */
+    TimerHandle(TimerHandle &&other);
+
+    /**
+     * TimerHandle destructor
+     * 
+     * Drops the handle's reference. The timer stays armed.
+     */
+    ~TimerHandle();
+
+    TimerHandle(const TimerHandle &) = delete;
+    TimerHandle &operator=(const TimerHandle &) = delete;
+
+    /**
+     * TimerHandle::cancel
+     * 
+     * Disarms the timer in O(1). A firing whose task already started isn't
+     * stopped.
+     * 
+     * Return Value: Returns true if the timer was armed, i.e. this stopped
+     *               it from firing (again).
+     */
+    bool cancel();
+};
+
+
+
+/**
+ * Worker class
+ */
+class Worker final {
+public:
+
+    /* lock: Only used as the pool's lock (see Winpool::lock). */
+    Lock lock;
+
+    /* taskQueue: Work-stealing deque that contains subtasks of tasks we're 
+                  executing that need to be executed. Not protected by lock. */
+    FutureDeque taskQueue;
+
+    /* slab: Allocator for Futures created by this worker's thread. Orphaned
+             (not deleted) when the worker is destroyed. */
+    FutureSlab *slab;
+
+    /* rngState: xorshift64* state used to pick steal victims. Only the 
+                 worker's own thread touches it. */
+    uint64_t rngState;
+
+    /* place: CPU the worker's thread runs on (or would, if it isn't 
+              pinned). */
+    CpuPlace place;
+
+    /* stealOrder: Indices of every other worker: the ones in our cluster, 
+                   then the rest of our NUMA node, then remote ones. Set by
+                   planStealing. */
+    UniquePtr<int[]> stealOrder;
+
+    /* nSameCluster: Number of workers at the start of stealOrder that 
+                     share our cluster. */
+    int nSameCluster;
+
+    /* nSameNode: Number of workers at the start of stealOrder on our NUMA 
+                  node, cluster included. */
+    int nSameNode;
+
+    /* state: A WorkerState. A parked worker sleeps on this word until 
+              Winpool::adjustWorkers sets it back to WORKER_ACTIVE. */
+    std::atomic<uint32_t> state;
+
+    /* blockingDepth: Number of BlockingRegions the worker's thread is in. 
+                      Only the worker's own thread touches it. */
+    int blockingDepth;
+
+    /* joinDepth: Number of worker gets the worker's thread is in, one 
+                  inside the other. Only the worker's own thread touches 
+                  it. */
+    int joinDepth;
+
+    /* joinVictim: While the worker is blocked in a get on a RUNNING Future,
+                   the worker executing that Future, otherwise nullptr. 
+                   Workers joining one of our tasks follow it to find work 
+                   (leapfrogging). */
+    std::atomic<Worker *> joinVictim;
+
+    /* bToken: Cancellation state of the task the worker is running, 
+               nullptr if none. Tasks it submits inherit it. */
+    CancelState *bToken;
+
+    /* Counters reported by Winpool::joinStats and Winpool::stats, on 
+       cache lines of their own. Only the worker's own thread writes them 
+       (plain load + store, see bumpCounter). */
+    alignas(64) std::atomic<uint64_t> nJoinWaits;
+    std::atomic<uint64_t> nJoinHelps;
+    std::atomic<uint64_t> joinWastedNs;
+    std::atomic<uint64_t> joinNs;
+    std::atomic<uint64_t> nTasks;
+    std::atomic<uint64_t> nCancelled;
+    std::atomic<uint64_t> nQueuePops;
+    std::atomic<uint64_t> nStealAttempts;
+    std::atomic<uint64_t> nSteals;
+    std::atomic<uint64_t> nYields;
+    std::atomic<uint64_t> nSleeps;
+    std::atomic<uint64_t> sleepNs;
+    std::atomic<uint64_t> parkedNs;
+    std::atomic<uint64_t> lockWaitNs;
+
+    /**
+     * Worker constructor
+     * 
+     * Initializes this instance with an empty taskQueue.
+     */
+    Worker();
+
+    /**
+     * Worker destructor
+     */
+    ~Worker();
+
+    /**
+     * Worker::nextRandom
+     * 
+     * Advances rngState. Only call this from the worker's own thread.
+     * 
+     * Return Value: Returns the next pseudo-random number.
+     */
+    uint64_t nextRandom();
+};
+
+
+
+/**
+ * Winpool class
+ */
+class Winpool final {
+public:
+
+    /* futures: Stands in as the owner of tasks submitted by external 
+                threads. */
+    FutureOwner futures;
+
+    /* taskQueue: Lock-free queue of tasks submitted by external threads. */
+    InjectionQueue taskQueue;
+
+    /* nWorkers: The number of worker slots, i.e. the most workers the pool
+                 can run at once. This is the size of the workerThreads and
+                 the workers array. A slot gets its thread the first time 
+                 it's needed. */
+    int nWorkers;
+
+    /* nStarted: Slots [0, nStarted) have had a thread started. Only 
+                 grows. */
+    std::atomic<int> nStarted;
+
+    /* nBaseWorkers: Number of workers asked for by createNew or 
+                     setWorkerCount. */
+    std::atomic<int> nBaseWorkers;
+
+    /* nBlocking: Number of workers inside a BlockingRegion. Each one gets a
+                  compensating worker, as long as there are slots left. */
+    std::atomic<int> nBlocking;
+
+    /* nPinned: Workers in slots [0, nPinned) are pinned to their place's 
+                CPU. */
+    int nPinned;
+
+    /* workerTls: Thread-local pointer to the calling thread's Worker object.
+                  This will be nullptr in external threads. */
+    TlsSlot workerTls;
+
+    /* lock: Keeps error messages from worker threads from interleaving.
+             Note: This will point to this->futures.lock. */
+    Lock *lock;
+
+    /* workerThreads: Points to a heap-allocated array of the worker 
+                      threads. */
+    UniquePtr<Thread[]> workerThreads;
+
+    /* workers: Points to heap-allocated array of Worker instances. Each worker
+                contains data needed for a worker thread. */
+    UniquePtr<Worker[]> workers;
+
+    /* workerDatas: Points to heap-allocated array of Worker instances */
+    UniquePtr<WorkerTProcData[]> workerDatas;
+
+    /* idleWorkers: Workers that ran out of tasks sleep on this. Anything that
+                    makes a task available notifies it. */
+    EventCount idleWorkers;
+
+    /* timers: Timers armed with submitAfter and submitEvery. */
+    TimerWheel timers;
+
+    /* running: Workers exit once this is false. Whoever clears it must 
+                notifyAll idleWorkers and unpark the parked workers. */
+    std::atomic<bool> running;
+
+    /* nIdle: Number of started workers asleep on idleWorkers or parked. 
+              shutdown sleeps on it until every worker is. */
+    std::atomic<uint32_t> nIdle;
+
+    /* aborting: Set by shutdown(SHUTDOWN_FAST): cancellable tasks are 
+                 skipped, and cancelRequested is true in running ones. */
+    std::atomic<bool> aborting;
+
+    /* shutDown: Set by the first call to shutdown. */
+    std::atomic<bool> shutDown;
+
+
+    /**
+     * Winpool::createNew
+     * 
+     * Creates and initializes a Winpool instance on the heap, starts up the 
+     * worker threads, passes ownership of this instance to the caller.
+     * Workers are spread over the CPUs the process may use, filling a 
+     * cluster (CPUs sharing a last level cache) and then a NUMA node before 
+     * moving on, pinned if there are at least as many CPUs as workers. They 
+     * steal from their own cluster first, then their node, then the rest.
+     * 
+     * nThreads: Number of worker threads to spawn.
+     * 
+     * Return Value: Returns a pointer to the newly created Winpool instance
+     *               that holds ownership of it.
+     */
+    static UniquePtr<Winpool> createNew(int nThreads);
+
+    /**
+     * Winpool::createNew
+     * 
+     * Like createNew(nThreads), with room for up to maxThreads workers 
+     * instead of workerHeadroom * nThreads.
+     * 
+     * nThreads: Number of worker threads to spawn.
+     * maxThreads: Most workers the pool will ever run at once, counting 
+     *             compensating ones. Raised to nThreads if lower.
+     * 
+     * Return Value: Returns a pointer to the newly created Winpool instance
+     *               that holds ownership of it.
+     */
+    static UniquePtr<Winpool> createNew(int nThreads, int maxThreads);
+
+
+    /**
+     * Winpool::submit
+     * 
+     * Adds a task to the pool's task queue. Once this is called, the pool may
+     * start executing the task immediately.
+     * 
+     * func: Function to execute.
+     * arg: Argument to pass to func.
+     * 
+     * Return Value: Returns a pointer to a heap-allocated Future which can
+     *               be used to obtain the task's result in the future.
+     *               The caller does NOT own this memory - do NOT delete: 
+     *               ownership of this memory is held by the pool until 
+     *               completion.
+     */
+    Future *submit(WinpoolTask func, void *arg);
+
+    /**
+     * Winpool::submit
+     * 
+     * Adds a task calling func(args...) to the pool. func and args are moved
+     * (or copied, for lvalues) into the Future itself, and so is the result
+     * once the task returns. Small tasks and results cost no heap 
+     * allocation.
+     * 
+     * func: Callable to execute.
+     * args: Arguments to pass to func.
+     * 
+     * Return Value: Returns a TypedFuture that can be used to obtain the 
+     *               task's result in the future.
+     */
+    template<class F, 
+             class... Args, 
+             class = typename std::enable_if<
+                 !IsLegacySubmit<F, Args...>::value
+             >::type>
+    TypedFuture<TaskResult<F, Args...>> submit(F &&func, Args &&...args);
+
+    /**
+     * Winpool::submit
+     * 
+     * Like submit(func, args...), in the given lane of the pool's queue. 
+     * Anything but PRIORITY_NORMAL goes to the pool's queue even from a 
+     * worker thread, so it's ordered against everything else submitted 
+     * with a priority.
+     * 
+     * priority: Lane to queue the task in.
+     * func: Callable to execute.
+     * args: Arguments to pass to func.
+     * 
+     * Return Value: Returns a TypedFuture that can be used to obtain the 
+     *               task's result in the future.
+     */
+    template<class F, class... Args>
+    TypedFuture<TaskResult<F, Args...>> submit(TaskPriority priority, 
+                                               F &&func, 
+                                               Args &&...args);
+
+    /**
+     * Winpool::submit
+     * 
+     * Like submit(func, args...), with the task (and everything it submits
+     * in turn) running under token - see CancelToken.
+     * 
+     * token: Token to cancel the task tree with.
+     * func: Callable to execute.
+     * args: Arguments to pass to func.
+     * 
+     * Return Value: Returns a TypedFuture that can be used to obtain the 
+     *               task's result in the future.
+     */
+    template<class F, class... Args>
+    TypedFuture<TaskResult<F, Args...>> submit(const CancelToken &token, 
+                                               F &&func, 
+                                               Args &&...args);
+
+    /**
+     * Winpool::spawn
+     * 
+     * Adds a fire-and-forget task calling func(args...) to the pool. Nobody
+     * can wait for it or get its result (which is discarded), so its 
+     * Future is detached: it's just the task's slot in the queue, deleted 
+     * as soon as the task returns, with no completion to publish.
+     * 
+     * func: Callable to execute.
+     * args: Arguments to pass to func.
+     */
+    template<class F, class... Args>
+    void spawn(F &&func, Args &&...args);
+
+    /**
+     * Winpool::submitAfter
+     * 
+     * Spawns a task calling func() once delayMs milliseconds have passed. 
+     * The pool's workers keep time, so no thread sleeps per timer.
+     * 
+     * delayMs: Delay before the task is spawned.
+     * func: Callable to execute.
+     * 
+     * Return Value: Returns a handle for cancelling the timer.
+     */
+    template<class F>
+    TimerHandle submitAfter(uint64_t delayMs, F &&func);
+
+    /**
+     * Winpool::submitEvery
+     * 
+     * Spawns a task calling func() every periodMs milliseconds, the first 
+     * one periodMs from now, until the timer is cancelled. If the pool falls
+     * behind, missed runs are skipped rather than bunched up. func must be 
+     * safe to call concurrently, since runs may overlap.
+     * 
+     * periodMs: Time between runs, at least one tick.
+     * func: Callable to execute.
+     * 
+     * Return Value: Returns a handle for cancelling the timer.
+     */
+    template<class F>
+    TimerHandle submitEvery(uint64_t periodMs, F &&func);
+
+    /**
+     * Winpool::submitFuture
+     * 
+     * Queues a Future that already has its task. Worker threads put it on 
+     * their own deque, external threads (and anything not PRIORITY_NORMAL)
+     * in its lane of the pool's queue.
+     * 
+     * fut: Future created with the task-less constructor, with ownership 
+     *      passed to this function.
+     * 
+     * Return Value: Returns a borrowed pointer to fut, owned by the pool 
+     *               until completion.
+     */
+    Future *submitFuture(UniquePtr<Future> fut);
+
+    /**
+     * Winpool::submitBatch
+     * 
+     * Adds nTasks tasks calling func(0), ..., func(nTasks - 1) to the pool.
+     * All of them are allocated in one block (see FutureBatch), queued with 
+     * a single queue operation and up to nTasks idle workers are woken up.
+     * func is moved into the block once and shared by all tasks, so it must
+     * be safe to call concurrently.
+     * 
+     * nTasks: Number of tasks.
+     * func: Callable taking a uint32_t task index.
+     * 
+     * Return Value: Returns a handle for joining the whole batch.
+     */
+    template<class F>
+    TaskBatch submitBatch(uint32_t nTasks, F &&func);
+
+    /**
+     * Winpool::submitBatch
+     * 
+     * Like submitBatch(nTasks, func), with one task calling func(*it) for 
+     * each iterator it in [first, last). The elements must outlive the 
+     * batch.
+     * 
+     * first: Start of the range (inclusive).
+     * last: End of the range (exclusive).
+     * func: Callable taking an element of the range.
+     * 
+     * Return Value: Returns a handle for joining the whole batch.
+     */
+    template<class It, class F>
+    TaskBatch submitBatch(It first, It last, F &&func);
+
+    /**
+     * Winpool::submitBatchFutures
+     * 
+     * Queues all Futures of a batch built by submitBatch: on the calling 
+     * worker's deque with one store, or on the pool's queue with one 
+     * exchange, then wakes up to nTasks idle workers.
+     * 
+     * batch: Batch whose Futures to queue. Ownership of the Futures is 
+     *        passed to the pool.
+     */
+    void submitBatchFutures(FutureBatch *batch);
+
+    /**
+     * Winpool::whenAll
+     * 
+     * Combines tasks into one that completes once all of them have. No 
+     * thread waits in the meantime: each task's completion counts down a
+     * shared counter, and the last one submits the combined task.
+     * 
+     * futs: Handles of the tasks to wait for, with ownership passed to this
+     *       function.
+     * 
+     * Return Value: Returns a TypedFuture whose result is futs, all of them
+     *               done, so their get doesn't block.
+     */
+    template<class T>
+    TypedFuture<std::vector<TypedFuture<T>>> whenAll(
+        std::vector<TypedFuture<T>> futs
+    );
+
+    /**
+     * Winpool::whenAny
+     * 
+     * Combines tasks into one that completes as soon as any of them has, 
+     * without any thread waiting in the meantime.
+     * 
+     * futs: Handles of the tasks to wait for, with ownership passed to this
+     *       function.
+     * 
+     * Return Value: Returns a TypedFuture whose result holds futs and the 
+     *               index of one that is done (SIZE_MAX if futs is empty).
+     */
+    template<class T>
+    TypedFuture<WhenAnyResult<T>> whenAny(std::vector<TypedFuture<T>> futs);
+
+    /**
+     * Winpool::parallelFor
+     * 
+     * Calls body(i) for every i in [first, last), spread over the workers,
+     * and returns once all calls have returned. The range is split lazily:
+     * a worker only hands half of what's left to thieves when its own 
+     * deque has run empty, so there's no grain size to tune.
+     * 
+     * first: Start of the range (inclusive). An integer or a random access
+     *        iterator.
+     * last: End of the range (exclusive).
+     * body: Callable taking an element of the range. Called concurrently.
+     */
+    template<class Index, class F>
+    void parallelFor(Index first, Index last, F &&body);
+
+    /**
+     * Winpool::parallelReduce
+     * 
+     * Reduces [first, last) in parallel, splitting it the same way as 
+     * parallelFor. Each piece is folded by body, starting from identity, and
+     * the pieces' results are combined in range order.
+     * 
+     * first: Start of the range (inclusive). An integer or a random access
+     *        iterator.
+     * last: End of the range (exclusive).
+     * identity: Result of an empty range.
+     * body: Callable taking (lo, hi, acc) that folds [lo, hi) into acc and
+     *       returns the result. Called concurrently.
+     * combine: Associative callable taking the results of two adjacent 
+     *          pieces (left, right) and returning their combination.
+     * 
+     * Return Value: Returns the result for the whole range.
+     */
+    template<class Index, class T, class Body, class Combine>
+    T parallelReduce(Index first, 
+                     Index last, 
+                     T identity, 
+                     Body &&body, 
+                     Combine &&combine);
+
+    /**
+     * Winpool::allocatorStats
+     * 
+     * Sums up the Future allocator counters of all workers. Safe to call 
+     * while the pool is running; the counters are only a snapshot then.
+     * 
+     * Return Value: Returns the summed counters.
+     */
+    AllocatorStats allocatorStats();
+
+    /**
+     * Winpool::joinStats
+     * 
+     * Sums up the join counters of all workers. Safe to call while the pool
+     * is running; the counters are only a snapshot then.
+     * 
+     * Return Value: Returns the summed counters.
+     */
+    JoinStats joinStats();
+
+    /**
+     * Winpool::stats
+     * 
+     * Collects the scheduler counters of every started worker, and their 
+     * sum. Safe to call while the pool is running; the counters are only
+     * a snapshot then.
+     * 
+     * Return Value: Returns the counters.
+     */
+    SchedulerStats stats();
+
+    /**
+     * Winpool::setWorkerCount
+     * 
+     * Grows or shrinks the set of running workers while the pool runs. 
+     * New workers start (or unpark) right away; extra ones retire once 
+     * they've emptied their own deque, parking so they cost nothing until 
+     * they're needed again.
+     * 
+     * nThreads: Number of workers to run, clamped to [1, nWorkers].
+     */
+    void setWorkerCount(int nThreads);
+
+    /**
+     * Winpool::activeTarget
+     * 
+     * Return Value: Returns how many workers should be running right now:
+     *               nBaseWorkers plus one per blocked worker, at most 
+     *               nWorkers.
+     */
+    int activeTarget();
+
+    /**
+     * Winpool::adjustWorkers
+     * 
+     * Starts or unparks every worker below activeTarget. Workers above it
+     * retire on their own.
+     */
+    void adjustWorkers();
+
+    /**
+     * Winpool::startWorker
+     * 
+     * Starts the thread of slot iWorker, pinning it if the slot is below 
+     * nPinned. The slot's state must already be WORKER_ACTIVE.
+     * Throws a SyscallError if the thread can't be created.
+     * 
+     * iWorker: Index of the slot.
+     */
+    void startWorker(int iWorker);
+
+    /**
+     * Winpool::enterBlocking
+     * 
+     * Counts the calling worker as blocked and brings in a worker to 
+     * compensate. See BlockingRegion.
+     * 
+     * Return Value: Returns false (and does nothing) if the calling thread
+     *               isn't one of the pool's workers.
+     */
+    bool enterBlocking();
+
+    /**
+     * Winpool::leaveBlocking
+     * 
+     * Undoes a successful enterBlocking. The compensating worker retires 
+     * on its own.
+     */
+    void leaveBlocking();
+
+    /**
+     * Winpool::addTimer
+     * 
+     * Arms a timer running task after delayNs, then every periodNs if that
+     * isn't 0. If its deadline is earlier than any idle worker will wake up
+     * for, wakes one up to keep time.
+     * 
+     * task: Callable to run.
+     * delayNs: Delay before the first run.
+     * periodNs: Time between runs, 0 for a single run.
+     * 
+     * Return Value: Returns a handle for cancelling the timer.
+     */
+    TimerHandle addTimer(TimerTask task, uint64_t delayNs, uint64_t periodNs);
+
+    /**
+     * Winpool::runTimers
+     * 
+     * If the timer wheel is due and no other worker is advancing it, 
+     * advances it and spawns the tasks of the timers that fired. Costs one
+     * load when no timers are armed.
+     */
+    void runTimers();
+
+    /**
+     * Winpool::cancelRequested
+     * 
+     * Lets a long-running task check whether it should stop early.
+     * 
+     * Return Value: Returns true if the calling task runs on one of this 
+     *               pool's workers under a cancelled token, or while 
+     *               the pool shuts down in SHUTDOWN_FAST mode.
+     */
+    bool cancelRequested();
+
+    /**
+     * Winpool::shutdown
+     * 
+     * Stops the pool: disarms its timers, lets the workers finish the 
+     * queued tasks (SHUTDOWN_DRAIN) or skips the cancellable ones among
+     * them (SHUTDOWN_FAST), then joins every worker thread once they're 
+     * all out of work. Tasks already running always finish; in fast mode
+     * cancelRequested tells them to hurry up. Don't submit from other 
+     * threads in the meantime. Only the first call does anything, and not
+     * from one of the pool's own workers, which can't join themselves. 
+     * The destructor drains if nobody shut the pool down before.
+     * 
+     * mode: What to do with the tasks that haven't started.
+     * 
+     * Return Value: Returns true if this call shut the pool down.
+     */
+    bool shutdown(ShutdownMode mode);
+
+    /**
+     * Winpool destructor
+     * 
+     * Shuts the pool down (draining it, unless shutdown was called before)
+     * and frees everything, its thread-local slot included.
+     */
+    ~Winpool();
+};
+
+} // end WinpoolNS
+
+
+
+#include <winpool_templates.hxx>
 
 
 
@@ -0,0 +1,408 @@
+/**
+ * winpool_platform.hxx
+ *
+ * Platform layer for the winpool library. Everything the pool needs from the
+ * operating system (locks, condition variables, threads, thread-local
+ * storage, sleeping and address waits) is declared here so the rest of the
+ * library never touches a Win32 or POSIX API directly.
+ *
+ * The Win32 implementation is selected when _WIN32 is defined, otherwise the
+ * Linux implementation (futexes, pthreads, thread_local) is used.
+ */
+
+
+
+#ifndef WINPOOL_PLATFORM_H
+#define WINPOOL_PLATFORM_H
+
+
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+
+
+/**
+ * Winpool namespace
+ */
+namespace WinpoolNS {
+
+
+/* ErrorCode: Error code type reported by the OS (GetLastError on Win32,
+              errno on Linux). */
+#ifdef _WIN32
+using ErrorCode = DWORD;
+#else
+using ErrorCode = int;
+#endif
+
+
+
+/**
+ * lastErrorCode
+ *
+ * Return Value: Returns the error code of the last failed syscall made by the
+ *               calling thread.
+ */
+ErrorCode lastErrorCode();
+
+
+
+/**
+ * sleepMs
+ *
+ * Suspends the calling thread for at least ms milliseconds.
+ */
+void sleepMs(uint32_t ms);
+
+
+
+/**
+ * yieldThread
+ *
+ * Gives up the rest of the calling thread's time slice.
+ */
+void yieldThread();
+
+
+
+/**
+ * monotonicNs
+ *
+ * Return Value: Returns the time in nanoseconds since some fixed point in 
+ *               the past. Never goes backwards; cheap enough to call from 
+ *               the scheduling hot path.
+ */
+uint64_t monotonicNs();
+
+
+
+/**
+ * waitOnAddress
+ *
+ * Blocks the calling thread while *addr == expected. Returns when another
+ * thread calls wakeAddressOne/wakeAddressAll on addr, or spuriously. Callers
+ * must re-check the condition they are waiting on.
+ *
+ * addr: Address of the word to wait on.
+ * expected: The value *addr must still hold for the thread to go to sleep.
+ */
+void waitOnAddress(std::atomic<uint32_t> *addr, uint32_t expected);
+
+
+
+/**
+ * waitOnAddressFor
+ *
+ * Like waitOnAddress, but also returns once timeoutNs nanoseconds have 
+ * passed.
+ *
+ * addr: Address of the word to wait on.
+ * expected: The value *addr must still hold for the thread to go to sleep.
+ * timeoutNs: Longest time to sleep for.
+ */
+void waitOnAddressFor(std::atomic<uint32_t> *addr, 
+                      uint32_t expected, 
+                      uint64_t timeoutNs);
+
+
+
+/**
+ * wakeAddressOne
+ *
+ * Wakes up at most one thread blocked in waitOnAddress on addr.
+ */
+void wakeAddressOne(std::atomic<uint32_t> *addr);
+
+
+
+/**
+ * wakeAddressAll
+ *
+ * Wakes up every thread blocked in waitOnAddress on addr.
+ */
+void wakeAddressAll(std::atomic<uint32_t> *addr);
+
+
+
+/**
+ * CpuPlace class
+ *
+ * Where a logical CPU sits in the machine.
+ */
+class CpuPlace final {
+public:
+
+    /* cpu: OS number of the logical CPU (group * 64 + number on Win32). */
+    uint32_t cpu;
+
+    /* node: NUMA node the CPU belongs to. */
+    uint32_t node;
+
+    /* cluster: Identifies the group of CPUs sharing the CPU's last level 
+                cache (the lowest CPU number in it). Unique machine-wide. */
+    uint32_t cluster;
+};
+
+
+
+/**
+ * discoverCpus
+ *
+ * Return Value: Returns the CPUs the process may run on, sorted by node, 
+ *               then cluster, then number, so CPUs that share a cache or a
+ *               memory controller are next to each other. Empty if the 
+ *               topology can't be read.
+ */
+std::vector<CpuPlace> discoverCpus();
+
+
+
+/**
+ * Lock class
+ *
+ * Mutual exclusion lock that spins for a short while before blocking.
+ * CRITICAL_SECTION on Win32, a futex-based mutex on Linux.
+ */
+class Lock final {
+public:
+
+#ifdef _WIN32
+    /* cs: The underlying critical section. */
+    CRITICAL_SECTION cs;
+#else
+    /* word: 0 = unlocked, 1 = locked, 2 = locked and threads may be blocked
+             in waitOnAddress on word. */
+    std::atomic<uint32_t> word;
+#endif
+
+
+    /**
+     * Lock constructor
+     *
+     * Initializes an unlocked lock.
+     * Throws a SyscallError if the lock can't be initialized.
+     */
+    Lock();
+
+    /**
+     * Lock destructor
+     */
+    ~Lock();
+
+    Lock(const Lock &) = delete;
+    Lock &operator=(const Lock &) = delete;
+
+    /**
+     * Lock::enter
+     *
+     * Acquires the lock, blocking until it's available.
+     */
+    void enter();
+
+    /**
+     * Lock::leave
+     *
+     * Releases the lock. Must be called by the thread holding it.
+     */
+    void leave();
+};
+
+
+
+/**
+ * CondVar class
+ *
+ * Condition variable used together with a Lock.
+ * CONDITION_VARIABLE on Win32, a futex sequence counter on Linux.
+ */
+class CondVar final {
+public:
+
+#ifdef _WIN32
+    /* cv: The underlying condition variable. */
+    CONDITION_VARIABLE cv;
+#else
+    /* seq: Bumped on every wake so sleepers can tell they were signalled. */
+    std::atomic<uint32_t> seq;
+#endif
+
+
+    /**
+     * CondVar constructor
+     */
+    CondVar();
+
+    CondVar(const CondVar &) = delete;
+    CondVar &operator=(const CondVar &) = delete;
+
+    /**
+     * CondVar::wait
+     *
+     * Atomically releases lock and sleeps until woken, then reacquires lock
+     * before returning. Wakeups may be spurious.
+     * Throws a SyscallError if the wait fails.
+     *
+     * lock: Lock held by the calling thread.
+     */
+    void wait(Lock *lock);
+
+    /**
+     * CondVar::wakeOne
+     *
+     * Wakes up at most one thread sleeping on this condition variable.
+     */
+    void wakeOne();
+
+    /**
+     * CondVar::wakeAll
+     *
+     * Wakes up all threads sleeping on this condition variable.
+     */
+    void wakeAll();
+};
+
+
+
+/**
+ * Thread class
+ *
+ * Handle to an OS thread.
+ */
+class Thread final {
+public:
+
+    /* Proc: Function type run by a Thread. */
+    using Proc = void (*)(void *arg);
+
+#ifdef _WIN32
+    /* handle: Win32 thread handle, nullptr if the thread isn't running. */
+    HANDLE handle;
+#else
+    /* handle: pthread id, only valid while started is true. */
+    pthread_t handle;
+#endif
+
+    /* started: Has start succeeded and join not been called yet? */
+    bool started;
+
+    /* proc: Function the thread runs. */
+    Proc proc;
+
+    /* arg: Argument passed to proc. */
+    void *arg;
+
+
+    /**
+     * Thread constructor
+     *
+     * Creates a handle with no thread behind it - call start.
+     */
+    Thread();
+
+    Thread(const Thread &) = delete;
+    Thread &operator=(const Thread &) = delete;
+
+    /**
+     * Thread::start
+     *
+     * Starts a new OS thread running proc(arg).
+     * Throws a SyscallError if the thread can't be created.
+     *
+     * proc: Function the new thread runs.
+     * arg: Argument passed to proc.
+     */
+    void start(Proc proc, void *arg);
+
+    /**
+     * Thread::join
+     *
+     * Blocks until the thread exits and releases its OS resources.
+     */
+    void join();
+
+    /**
+     * Thread::pinToCpu
+     *
+     * Restricts the started thread to run on one logical CPU.
+     *
+     * cpu: CpuPlace::cpu of the CPU.
+     *
+     * Return Value: Returns false if the OS refused, in which case the 
+     *               thread may keep running anywhere.
+     */
+    bool pinToCpu(uint32_t cpu);
+};
+
+
+
+/**
+ * TlsSlot class
+ *
+ * A thread-local pointer variable that can be created at runtime (one per
+ * Winpool). Every thread sees nullptr until it sets its own value.
+ *
+ * On Linux this is backed by native thread_local storage: each thread can
+ * hold a value for one TlsSlot at a time, which is all the pool needs since a
+ * thread is a worker of at most one pool.
+ */
+class TlsSlot final {
+public:
+
+#ifdef _WIN32
+    /* index: Index returned by TlsAlloc. */
+    DWORD index;
+#else
+    /* tlsOwner: The TlsSlot the calling thread's tlsValue belongs to. */
+    static thread_local const TlsSlot *tlsOwner;
+
+    /* tlsValue: The calling thread's value for tlsOwner. */
+    static thread_local void *tlsValue;
+#endif
+
+
+    /**
+     * TlsSlot constructor
+     *
+     * Throws a SyscallError if no thread-local slot can be allocated.
+     */
+    TlsSlot();
+
+    /**
+     * TlsSlot destructor
+     *
+     * Frees the slot.
+     */
+    ~TlsSlot();
+
+    TlsSlot(const TlsSlot &) = delete;
+    TlsSlot &operator=(const TlsSlot &) = delete;
+
+    /**
+     * TlsSlot::get
+     *
+     * Return Value: Returns the calling thread's value for this slot, nullptr
+     *               if the thread never set one.
+     */
+    void *get() const;
+
+    /**
+     * TlsSlot::set
+     *
+     * Sets the calling thread's value for this slot.
+     * Throws a SyscallError on failure.
+     */
+    void set(void *value);
+};
+
+} // end WinpoolNS
+
+
+
+#endif // ifndef WINPOOL_PLATFORM_H
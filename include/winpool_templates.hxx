@@ -0,0 +1,1095 @@
+/**
+ * winpool_templates.hxx
+ * 
+ * Definitions of the winpool class and member templates. Included at the end
+ * of winpool.hxx and _winpool_private.hxx - don't include this directly.
+ */
+
+
+
+#ifndef WINPOOL_TEMPLATES_H
+#define WINPOOL_TEMPLATES_H
+
+
+
+/**
+ * Winpool namespace
+ */
+namespace WinpoolNS {
+
+
+/* resultInRes: Results of type T are kept in Future::res itself rather than 
+                stored in the Future. */
+template<class T>
+constexpr bool resultInRes = 
+    std::is_void<T>::value || 
+    std::is_pointer<T>::value || 
+    std::is_null_pointer<T>::value;
+
+
+
+/**
+ * bumpCounter
+ * 
+ * Adds n to a statistics counter that only the calling thread writes: a 
+ * relaxed load and store, so readers on other threads see whole values 
+ * without the cost of a read-modify-write.
+ */
+template<class T>
+inline void bumpCounter(std::atomic<T> *counter, T n) {
+    counter->store(
+        counter->load(std::memory_order_relaxed) + n, 
+        std::memory_order_relaxed
+    );
+}
+
+
+
+/**
+ * TaskSlot class template
+ * 
+ * Places a T (a task's callable or its result) in a Future's taskStorage if
+ * it fits, otherwise on the heap with taskStorage holding the pointer.
+ */
+template<class T>
+class TaskSlot final {
+public:
+
+    /* isInline: Does a T fit in taskStorage? */
+    static constexpr bool isInline = 
+        sizeof(T) <= taskStorageSize && 
+        alignof(T) <= alignof(std::max_align_t);
+
+
+    /**
+     * TaskSlot::emplace
+     * 
+     * Constructs a T from args in storage.
+     * 
+     * Return Value: Returns a pointer to the new T.
+     */
+    template<class... Args>
+    static T *emplace(unsigned char *storage, Args &&...args) {
+        if constexpr (isInline) {
+            return new (storage) T(std::forward<Args>(args)...);
+        }
+        else {
+            return *new (storage) T *(new T(std::forward<Args>(args)...));
+        }
+    }
+
+    /**
+     * TaskSlot::get
+     * 
+     * Return Value: Returns a pointer to the T emplaced in storage.
+     */
+    static T *get(unsigned char *storage) {
+        if constexpr (isInline) {
+            return std::launder((T *)storage);
+        }
+        else {
+            return *std::launder((T **)storage);
+        }
+    }
+
+    /**
+     * TaskSlot::destroy
+     * 
+     * Destroys the T emplaced in storage.
+     */
+    static void destroy(unsigned char *storage) {
+        if constexpr (isInline) {
+            get(storage)->~T();
+        }
+        else {
+            delete get(storage);
+        }
+    }
+};
+
+
+
+/**
+ * TypedFuture class template
+ * 
+ * Handle to a task submitted with the typed Winpool::submit. The result (of
+ * type T) is stored in the task's Future; get moves it out. The handle 
+ * holds the Future's handle reference, so a TypedFuture dropped without 
+ * get lets the pool reclaim the Future as soon as the task is done.
+ */
+template<class T>
+class TypedFuture final {
+public:
+
+    /* bFuture: Pointer to the task's Future, holding its handle reference.
+                nullptr once get was called or the handle was moved from. */
+    Future *bFuture;
+
+
+    /**
+     * TypedFuture default constructor
+     * 
+     * Creates an empty handle to assign a submitted task to later.
+     */
+    TypedFuture() {
+        this->bFuture = nullptr;
+    }
+
+    /**
+     * TypedFuture constructor
+     * 
+     * bFuture: Submitted Future whose task returns a T, with its handle 
+     *          reference passed to this TypedFuture.
+     */
+    TypedFuture(Future *bFuture) {
+        this->bFuture = bFuture;
+    }
+
+    /**
+     * TypedFuture move constructor
+     */
+    TypedFuture(TypedFuture &&other) {
+        this->bFuture = other.bFuture;
+        other.bFuture = nullptr;
+    }
+
+    /**
+     * TypedFuture move assignment
+     * 
+     * Drops the task this handle held, if any, and takes over other's.
+     */
+    TypedFuture &operator=(TypedFuture &&other) {
+        if (this != &other) {
+            if (this->bFuture != nullptr) {
+                this->bFuture->release();
+            }
+            this->bFuture = other.bFuture;
+            other.bFuture = nullptr;
+        }
+        return *this;
+    }
+
+    TypedFuture(const TypedFuture &) = delete;
+    TypedFuture &operator=(const TypedFuture &) = delete;
+
+    /**
+     * TypedFuture destructor
+     * 
+     * Drops the handle reference without waiting for the task.
+     */
+    ~TypedFuture() {
+        if (this->bFuture != nullptr) {
+            this->bFuture->release();
+        }
+    }
+
+    /**
+     * TypedFuture::get
+     * 
+     * Waits for the task to complete (see Future::get) and returns its 
+     * result. The Future is discarded afterwards, so only call this once.
+     * Throws TaskCancelled if the task was cancelled.
+     * 
+     * Return Value: Returns the result returned by the task.
+     */
+    T get() {
+
+        Future *bFut = this->bFuture;
+        void *res = bFut->join();
+        this->bFuture = nullptr;
+
+        if (bFut->cancelled) {
+            bFut->release();
+            throw TaskCancelled();
+        }
+
+        if constexpr (std::is_void<T>::value) {
+            bFut->release();
+        }
+        else if constexpr (resultInRes<T>) {
+            bFut->release();
+            return (T)res;
+        }
+        else {
+            // Moved out before the last reference destroys what's left of it
+            T result = std::move(*(T *)res);
+            bFut->release();
+            return result;
+        }
+    }
+
+    /**
+     * TypedFuture::tryGet
+     * 
+     * Like get if the task is done; otherwise returns right away, keeping
+     * the handle for later. Never blocks or takes a lock.
+     * 
+     * Return Value: Returns the task's result, or nothing if it isn't done.
+     *               For void tasks, returns whether it was done.
+     */
+    TryGetResult<T> tryGet() {
+        if (this->bFuture->status.load(std::memory_order_acquire) != DONE) {
+            return TryGetResult<T>();
+        }
+        if constexpr (std::is_void<T>::value) {
+            this->get();
+            return true;
+        }
+        else {
+            return TryGetResult<T>(this->get());
+        }
+    }
+
+    /**
+     * TypedFuture::waitUntil
+     * 
+     * Waits for the task until deadlineNs at the latest (see 
+     * Future::waitUntil). Keeps the handle: get doesn't block afterwards
+     * if this returned true.
+     * 
+     * deadlineNs: Time to give up at, on the monotonicNs clock.
+     * 
+     * Return Value: Returns true if the task is done.
+     */
+    bool waitUntil(uint64_t deadlineNs) {
+        return this->bFuture->waitUntil(deadlineNs);
+    }
+
+    /**
+     * TypedFuture::waitFor
+     * 
+     * Like waitUntil, giving up after timeoutNs nanoseconds.
+     * 
+     * timeoutNs: Longest time to wait for.
+     * 
+     * Return Value: Returns true if the task is done.
+     */
+    bool waitFor(uint64_t timeoutNs) {
+        return this->bFuture->waitFor(timeoutNs);
+    }
+
+    /**
+     * TypedFuture::cancel
+     * 
+     * Cancels the task if it hasn't started (see Future::cancel). get still
+     * waits for it to be skipped, then throws TaskCancelled.
+     * 
+     * Return Value: Returns true if the task won't run.
+     */
+    bool cancel() {
+        return this->bFuture->cancel();
+    }
+
+    /**
+     * TypedFuture::then
+     * 
+     * Chains func onto the task: once the task completes, func is 
+     * submitted to the pool and called with its result (with nothing if T
+     * is void). No thread blocks in the meantime. The handle is moved into
+     * the continuation, so it's empty afterwards. If the task is 
+     * cancelled, so is func's.
+     * 
+     * func: Callable to execute after the task.
+     * 
+     * Return Value: Returns a TypedFuture for func's result.
+     */
+    template<class F>
+    TypedFuture<ThenResult<T, F>> then(F &&func) {
+
+        Future *bAnte = this->bFuture;
+        UniquePtr<Future> uCont = 
+            UniquePtr<Future>(new Future(bAnte->bPool));
+        uCont->cancellable = true;
+        uCont->setTask(
+            [ante = std::move(*this), 
+             func = std::forward<F>(func)]() mutable {
+                // ante is DONE by now: get doesn't wait
+                if constexpr (std::is_void<T>::value) {
+                    ante.get();
+                    return func();
+                }
+                else {
+                    return func(ante.get());
+                }
+            }
+        );
+
+        Future *bCont = uCont.get();
+        bAnte->addContinuation(std::move(uCont));
+        return TypedFuture<ThenResult<T, F>>(bCont);
+    }
+};
+
+
+
+/**
+ * WhenAnyResult class template
+ * 
+ * Result of Winpool::whenAny.
+ */
+template<class T>
+class WhenAnyResult final {
+public:
+
+    /* index: Index in futures of a task that is done. SIZE_MAX if futures is
+              empty. */
+    size_t index;
+
+    /* futures: The tasks passed to whenAny. */
+    std::vector<TypedFuture<T>> futures;
+};
+
+
+
+/**
+ * Future::setTask
+ * 
+ * Moves a callable into this Future as its task (lvalues are copied). 
+ * Callables of up to taskStorageSize bytes are stored inline, so this 
+ * doesn't allocate; bigger ones are moved to the heap. Only call this 
+ * once, before the Future is submitted.
+ * 
+ * func: Callable taking no arguments. Pointer results (and void) are 
+ *       kept in res, anything else is stored in the Future - see 
+ *       TypedFuture::get.
+ */
+template<class F>
+void Future::setTask(F &&func) {
+
+    using Fn = typename std::decay<F>::type;
+    using R = typename std::decay<typename std::invoke_result<Fn &>::type>::type;
+
+    TaskSlot<Fn>::emplace(this->taskStorage, std::forward<F>(func));
+
+    this->invokeTask = [](Future *fut) {
+
+        Fn *fn = TaskSlot<Fn>::get(fut->taskStorage);
+
+        if constexpr (std::is_void<R>::value) {
+            (*fn)();
+            fut->res = nullptr;
+            TaskSlot<Fn>::destroy(fut->taskStorage);
+            fut->destroyTask = nullptr;
+        }
+        else if constexpr (resultInRes<R>) {
+            fut->res = (void *)(*fn)();
+            TaskSlot<Fn>::destroy(fut->taskStorage);
+            fut->destroyTask = nullptr;
+        }
+        else {
+            // The result takes the callable's place in taskStorage
+            R result = (*fn)();
+            TaskSlot<Fn>::destroy(fut->taskStorage);
+            fut->destroyTask = nullptr;
+
+            fut->res = TaskSlot<R>::emplace(
+                fut->taskStorage, 
+                std::move(result)
+            );
+            fut->destroyTask = [](Future *doneFut) {
+                TaskSlot<R>::destroy(doneFut->taskStorage);
+            };
+        }
+    };
+
+    this->destroyTask = [](Future *fut) {
+        TaskSlot<Fn>::destroy(fut->taskStorage);
+    };
+}
+
+
+
+/**
+ * Winpool::submit
+ * 
+ * Adds a task calling func(args...) to the pool. func and args are moved
+ * (or copied, for lvalues) into the Future itself, and so is the result
+ * once the task returns. Small tasks and results cost no heap 
+ * allocation.
+ * 
+ * func: Callable to execute.
+ * args: Arguments to pass to func.
+ * 
+ * Return Value: Returns a TypedFuture that can be used to obtain the 
+ *               task's result in the future.
+ */
+template<class F, class... Args, class>
+TypedFuture<TaskResult<F, Args...>> Winpool::submit(F &&func, 
+                                                    Args &&...args) {
+
+    UniquePtr<Future> uFuture = UniquePtr<Future>(new Future(this));
+    uFuture->cancellable = true;
+    uFuture->setTask(
+        [func = std::forward<F>(func),
+         args = std::tuple<typename std::decay<Args>::type...>(
+             std::forward<Args>(args)...
+         )]() mutable {
+            return std::apply(std::move(func), std::move(args));
+        }
+    );
+
+    return TypedFuture<TaskResult<F, Args...>>(
+        this->submitFuture(std::move(uFuture))
+    );
+}
+
+
+
+/**
+ * Winpool::submit
+ * 
+ * Like submit(func, args...), in the given lane of the pool's queue. 
+ * Anything but PRIORITY_NORMAL goes to the pool's queue even from a 
+ * worker thread, so it's ordered against everything else submitted 
+ * with a priority.
+ * 
+ * priority: Lane to queue the task in.
+ * func: Callable to execute.
+ * args: Arguments to pass to func.
+ * 
+ * Return Value: Returns a TypedFuture that can be used to obtain the 
+ *               task's result in the future.
+ */
+template<class F, class... Args>
+TypedFuture<TaskResult<F, Args...>> Winpool::submit(TaskPriority priority,
+                                                    F &&func, 
+                                                    Args &&...args) {
+
+    UniquePtr<Future> uFuture = UniquePtr<Future>(new Future(this));
+    uFuture->priority = priority;
+    uFuture->cancellable = true;
+    uFuture->setTask(
+        [func = std::forward<F>(func),
+         args = std::tuple<typename std::decay<Args>::type...>(
+             std::forward<Args>(args)...
+         )]() mutable {
+            return std::apply(std::move(func), std::move(args));
+        }
+    );
+
+    return TypedFuture<TaskResult<F, Args...>>(
+        this->submitFuture(std::move(uFuture))
+    );
+}
+
+
+
+/**
+ * Winpool::submit
+ * 
+ * Like submit(func, args...), with the task (and everything it submits
+ * in turn) running under token - see CancelToken.
+ * 
+ * token: Token to cancel the task tree with.
+ * func: Callable to execute.
+ * args: Arguments to pass to func.
+ * 
+ * Return Value: Returns a TypedFuture that can be used to obtain the 
+ *               task's result in the future.
+ */
+template<class F, class... Args>
+TypedFuture<TaskResult<F, Args...>> Winpool::submit(const CancelToken &token,
+                                                    F &&func, 
+                                                    Args &&...args) {
+
+    UniquePtr<Future> uFuture = UniquePtr<Future>(new Future(this));
+    uFuture->cancellable = true;
+    uFuture->token = token.state;
+    token.state->addRef();
+    uFuture->setTask(
+        [func = std::forward<F>(func),
+         args = std::tuple<typename std::decay<Args>::type...>(
+             std::forward<Args>(args)...
+         )]() mutable {
+            return std::apply(std::move(func), std::move(args));
+        }
+    );
+
+    return TypedFuture<TaskResult<F, Args...>>(
+        this->submitFuture(std::move(uFuture))
+    );
+}
+
+
+
+/**
+ * Winpool::spawn
+ * 
+ * Adds a fire-and-forget task calling func(args...) to the pool. Nobody
+ * can wait for it or get its result (which is discarded), so its 
+ * Future is detached: it's just the task's slot in the queue, deleted 
+ * as soon as the task returns, with no completion to publish. A 
+ * TaskCancelled it throws is dropped like the result.
+ * 
+ * func: Callable to execute.
+ * args: Arguments to pass to func.
+ */
+template<class F, class... Args>
+void Winpool::spawn(F &&func, Args &&...args) {
+
+    UniquePtr<Future> uFuture = UniquePtr<Future>(new Future(this));
+    uFuture->detached = true;
+    uFuture->nRefs.store(1, std::memory_order_relaxed);
+    uFuture->setTask(
+        [func = std::forward<F>(func),
+         args = std::tuple<typename std::decay<Args>::type...>(
+             std::forward<Args>(args)...
+         )]() mutable {
+            try {
+                std::apply(std::move(func), std::move(args));
+            }
+            catch (TaskCancelled &) {
+                // Nobody to tell
+            }
+        }
+    );
+
+    this->submitFuture(std::move(uFuture));
+}
+
+
+
+/**
+ * Winpool::submitAfter
+ * 
+ * Spawns a task calling func() once delayMs milliseconds have passed. 
+ * The pool's workers keep time, so no thread sleeps per timer.
+ * 
+ * delayMs: Delay before the task is spawned.
+ * func: Callable to execute.
+ * 
+ * Return Value: Returns a handle for cancelling the timer.
+ */
+template<class F>
+TimerHandle Winpool::submitAfter(uint64_t delayMs, F &&func) {
+    return this->addTimer(
+        TimerTask(std::forward<F>(func)), 
+        delayMs * 1000000, 
+        0
+    );
+}
+
+
+
+/**
+ * Winpool::submitEvery
+ * 
+ * Spawns a task calling func() every periodMs milliseconds, the first 
+ * one periodMs from now, until the timer is cancelled. If the pool falls
+ * behind, missed runs are skipped rather than bunched up. func must be 
+ * safe to call concurrently, since runs may overlap.
+ * 
+ * periodMs: Time between runs, at least one tick.
+ * func: Callable to execute.
+ * 
+ * Return Value: Returns a handle for cancelling the timer.
+ */
+template<class F>
+TimerHandle Winpool::submitEvery(uint64_t periodMs, F &&func) {
+    return this->addTimer(
+        TimerTask(std::forward<F>(func)), 
+        periodMs * 1000000, 
+        periodMs * 1000000
+    );
+}
+
+
+
+/**
+ * Winpool::submitBatch
+ * 
+ * Adds nTasks tasks calling func(0), ..., func(nTasks - 1) to the pool.
+ * All of them are allocated in one block (see FutureBatch), queued with 
+ * a single queue operation and up to nTasks idle workers are woken up.
+ * func is moved into the block once and shared by all tasks, so it must
+ * be safe to call concurrently.
+ * 
+ * nTasks: Number of tasks.
+ * func: Callable taking a uint32_t task index.
+ * 
+ * Return Value: Returns a handle for joining the whole batch.
+ */
+template<class F>
+TaskBatch Winpool::submitBatch(uint32_t nTasks, F &&func) {
+
+    using Fn = typename std::decay<F>::type;
+    static_assert(alignof(Fn) <= alignof(std::max_align_t),
+                  "submitBatch callables can't be over-aligned");
+
+    FutureBatch *batch = FutureBatch::create(this, nTasks, sizeof(Fn));
+    Fn *bFunc = ::new (batch->funcStorage) Fn(std::forward<F>(func));
+    batch->destroyFunc = [](void *funcStorage) {
+        ((Fn *)funcStorage)->~Fn();
+    };
+
+    for (uint32_t iTask = 0; iTask < nTasks; iTask++) {
+        Future *fut = batch->newFuture(iTask);
+        fut->setTask([bFunc, batch, iTask]() {
+            try {
+                (*bFunc)(iTask);
+            }
+            catch (TaskCancelled &) {
+                // The task still counts as finished
+            }
+            batch->finishTask();
+        });
+    }
+
+    this->submitBatchFutures(batch);
+    return TaskBatch(batch);
+}
+
+
+
+/**
+ * Winpool::submitBatch
+ * 
+ * Like submitBatch(nTasks, func), with one task calling func(*it) for 
+ * each iterator it in [first, last). The elements must outlive the 
+ * batch.
+ * 
+ * first: Start of the range (inclusive).
+ * last: End of the range (exclusive).
+ * func: Callable taking an element of the range.
+ * 
+ * Return Value: Returns a handle for joining the whole batch.
+ */
+template<class It, class F>
+TaskBatch Winpool::submitBatch(It first, It last, F &&func) {
+
+    using Fn = typename std::decay<F>::type;
+    static_assert(alignof(Fn) <= alignof(std::max_align_t),
+                  "submitBatch callables can't be over-aligned");
+
+    uint32_t nTasks = (uint32_t)std::distance(first, last);
+
+    FutureBatch *batch = FutureBatch::create(this, nTasks, sizeof(Fn));
+    Fn *bFunc = ::new (batch->funcStorage) Fn(std::forward<F>(func));
+    batch->destroyFunc = [](void *funcStorage) {
+        ((Fn *)funcStorage)->~Fn();
+    };
+
+    It it = first;
+    for (uint32_t iTask = 0; iTask < nTasks; iTask++, ++it) {
+        Future *fut = batch->newFuture(iTask);
+        fut->setTask([bFunc, batch, it]() {
+            try {
+                (*bFunc)(*it);
+            }
+            catch (TaskCancelled &) {
+                // The task still counts as finished
+            }
+            batch->finishTask();
+        });
+    }
+
+    this->submitBatchFutures(batch);
+    return TaskBatch(batch);
+}
+
+
+
+/**
+ * TaskGroup::run
+ * 
+ * Spawns a child calling func(args...) into the group. Its result is 
+ * discarded.
+ * 
+ * func: Callable to execute.
+ * args: Arguments to pass to func.
+ */
+template<class F, class... Args>
+void TaskGroup::run(F &&func, Args &&...args) {
+
+    // Count the child before it can possibly finish
+    this->state.fetch_add(1, std::memory_order_relaxed);
+
+    TaskGroup *bGroup = this;
+    this->bPool->spawn(
+        [bGroup, 
+         func = std::forward<F>(func),
+         args = std::tuple<typename std::decay<Args>::type...>(
+             std::forward<Args>(args)...
+         )]() mutable {
+            try {
+                std::apply(std::move(func), std::move(args));
+            }
+            catch (TaskCancelled &) {
+                // The child still counts as finished
+            }
+            bGroup->finishTask();
+        }
+    );
+}
+
+
+
+/**
+ * WhenState class template
+ * 
+ * Shared by the continuations Winpool::whenAll and whenAny chain onto each
+ * task and the combined task they submit. Reference counted, since 
+ * whenAny's combined task may run before every continuation has.
+ */
+template<class T>
+class WhenState final {
+public:
+
+    /* futs: The tasks being waited for, until the combined task moves them
+             into its result. */
+    std::vector<TypedFuture<T>> futs;
+
+    /* bResult: The combined task, owned by this state until it's 
+                submitted. */
+    Future *bResult;
+
+    /* nPending: Completions still needed before bResult is submitted, plus
+                 one for whenAll/whenAny until every continuation is 
+                 attached. */
+    std::atomic<size_t> nPending;
+
+    /* nRefs: One reference per continuation and one for bResult's task. */
+    std::atomic<size_t> nRefs;
+
+    /* fired: Set by the first task to complete (whenAny). */
+    std::atomic<bool> fired;
+
+    /* iFirst: Index of the first task to complete (whenAny). */
+    size_t iFirst;
+
+
+    /**
+     * WhenState::fire
+     * 
+     * Counts down nPending, submitting bResult after the last one.
+     */
+    void fire() {
+        if (this->nPending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            Future *bRes = this->bResult;
+            bRes->bPool->submitFuture(UniquePtr<Future>(bRes));
+        }
+    }
+
+    /**
+     * WhenState::release
+     * 
+     * Drops a reference, deleting this state after the last one.
+     */
+    void release() {
+        if (this->nRefs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete this;
+        }
+    }
+
+    /**
+     * WhenState::attach
+     * 
+     * Chains a detached continuation calling onDone() onto every task in 
+     * futs, then drops the attaching count from nPending.
+     */
+    template<class OnDone>
+    void attach(Winpool *bPool, OnDone onDone) {
+        for (size_t iFut = 0; iFut < this->futs.size(); iFut++) {
+            UniquePtr<Future> uCont = UniquePtr<Future>(new Future(bPool));
+            uCont->detached = true;
+            uCont->nRefs.store(1, std::memory_order_relaxed);
+            uCont->setTask([onDone, iFut]() { onDone(iFut); });
+            this->futs[iFut].bFuture->addContinuation(std::move(uCont));
+        }
+        this->fire();
+    }
+};
+
+
+
+/**
+ * Winpool::whenAll
+ * 
+ * Combines tasks into one that completes once all of them have. No thread
+ * waits in the meantime: each task's completion counts down a shared 
+ * counter, and the last one submits the combined task.
+ * 
+ * futs: Handles of the tasks to wait for, with ownership passed to this 
+ *       function.
+ * 
+ * Return Value: Returns a TypedFuture whose result is futs, all of them 
+ *               done, so their get doesn't block.
+ */
+template<class T>
+TypedFuture<std::vector<TypedFuture<T>>> Winpool::whenAll(
+    std::vector<TypedFuture<T>> futs
+) {
+
+    WhenState<T> *state = new WhenState<T>();
+    size_t nFuts = futs.size();
+    state->futs = std::move(futs);
+    state->nPending.store(nFuts + 1, std::memory_order_relaxed);
+    state->nRefs.store(nFuts + 1, std::memory_order_relaxed);
+
+    UniquePtr<Future> uResult = UniquePtr<Future>(new Future(this));
+    uResult->setTask([state]() {
+        std::vector<TypedFuture<T>> doneFuts = std::move(state->futs);
+        state->release();
+        return doneFuts;
+    });
+    state->bResult = uResult.release();
+    TypedFuture<std::vector<TypedFuture<T>>> handle(state->bResult);
+
+    state->attach(this, [state](size_t iFut) {
+        state->fire();
+        state->release();
+    });
+
+    return handle;
+}
+
+
+
+/**
+ * Winpool::whenAny
+ * 
+ * Combines tasks into one that completes as soon as any of them has, 
+ * without any thread waiting in the meantime.
+ * 
+ * futs: Handles of the tasks to wait for, with ownership passed to this 
+ *       function.
+ * 
+ * Return Value: Returns a TypedFuture whose result holds futs and the 
+ *               index of one that is done (SIZE_MAX if futs is empty).
+ */
+template<class T>
+TypedFuture<WhenAnyResult<T>> Winpool::whenAny(
+    std::vector<TypedFuture<T>> futs
+) {
+
+    WhenState<T> *state = new WhenState<T>();
+    size_t nFuts = futs.size();
+    state->futs = std::move(futs);
+    state->nPending.store(nFuts == 0 ? 1 : 2, std::memory_order_relaxed);
+    state->nRefs.store(nFuts + 1, std::memory_order_relaxed);
+    state->fired.store(false, std::memory_order_relaxed);
+    state->iFirst = SIZE_MAX;
+
+    UniquePtr<Future> uResult = UniquePtr<Future>(new Future(this));
+    uResult->setTask([state]() {
+        WhenAnyResult<T> result;
+        result.index = state->iFirst;
+        result.futures = std::move(state->futs);
+        state->release();
+        return result;
+    });
+    state->bResult = uResult.release();
+    TypedFuture<WhenAnyResult<T>> handle(state->bResult);
+
+    // Only the first completion counts; the rest just drop their reference
+    state->attach(this, [state](size_t iFut) {
+        if (!state->fired.exchange(true, std::memory_order_relaxed)) {
+            state->iFirst = iFut;
+            state->fire();
+        }
+        state->release();
+    });
+
+    return handle;
+}
+
+
+
+/**
+ * RangeReducer class template
+ * 
+ * Does the work of Winpool::parallelReduce (and parallelFor) with lazy 
+ * binary splitting: a worker folds its range a few iterations at a time 
+ * and, whenever its own deque is empty - everything it offered has been 
+ * stolen, so thieves are hungry - submits the upper half of what's left as
+ * a new task. While the deque isn't empty nothing is split, so a range no 
+ * one steals from costs a handful of tasks however big it is.
+ * 
+ * The iterations run between checks start at 1 and double up to 
+ * splitCheckInterval, so expensive bodies are split early and cheap ones
+ * are checked rarely. Pieces the time per iteration so far says are worth
+ * less than minSplitNs are never split off.
+ */
+template<class Index, class T, class Body, class Combine>
+class RangeReducer final {
+public:
+
+    /* maxSplits: A range is halved at most once per bit of its length. */
+    static const int maxSplits = 64;
+
+    /* bPool: Borrowed pointer to the pool the pieces are submitted to. */
+    Winpool *bPool;
+
+    /* bIdentity: Borrowed pointer to the value each piece's fold starts 
+                  from. */
+    const T *bIdentity;
+
+    /* bBody: Borrowed pointer to the body folding a piece. */
+    Body *bBody;
+
+    /* bCombine: Borrowed pointer to the callable combining two pieces. */
+    Combine *bCombine;
+
+
+    /**
+     * RangeReducer::run
+     * 
+     * Reduces [lo, hi) on the calling worker, splitting pieces off for 
+     * thieves along the way, and joins them.
+     * 
+     * Return Value: Returns the result for [lo, hi).
+     */
+    T run(Index lo, Index hi) const {
+
+        Worker *bMyWorker = (Worker *)this->bPool->workerTls.get();
+
+        // Pieces split off from the top of the range, newest (lowest) last
+        TypedFuture<T> uppers[maxSplits];
+        int nUppers = 0;
+        T acc = *this->bIdentity;
+
+        uint64_t startNs = monotonicNs();
+        int64_t nDone = 0;
+        int64_t chunkSize = 1;
+        bool worthSplitting = true;
+        double nsPerIter = -1;
+
+        while (lo != hi) {
+
+            Index chunkEnd = hi - lo > chunkSize ? lo + chunkSize : hi;
+            nDone += chunkEnd - lo;
+            acc = (*this->bBody)(lo, chunkEnd, std::move(acc));
+            lo = chunkEnd;
+
+            if (chunkSize < splitCheckInterval)
+                chunkSize *= 2;
+
+            // Thieves took all we had to offer: offer the upper half of 
+            // what's left
+            if (worthSplitting && 
+                hi - lo > 1 && 
+                nUppers < maxSplits && 
+                bMyWorker->taskQueue.empty()) {
+
+                // Too little work left to be worth a task? The rest only 
+                // shrinks, so stop asking. The clock is read once; later 
+                // checks reuse the time per iteration it gave.
+                if (nsPerIter < 0) {
+                    nsPerIter = 
+                        (double)(monotonicNs() - startNs) / (double)nDone;
+                }
+                if (nsPerIter * (double)((hi - lo) / 2) < (double)minSplitNs) {
+                    worthSplitting = false;
+                    continue;
+                }
+
+                Index mid = lo + (hi - lo) / 2;
+                const RangeReducer *bThis = this;
+                uppers[nUppers++] = this->bPool->submit([bThis, mid, hi]() {
+                    return bThis->run(mid, hi);
+                });
+                hi = mid;
+            }
+        }
+
+        // The newest piece is at the bottom of our deque and lies right above
+        // acc's range, so joining in reverse keeps the pieces in range order
+        for (int iUpper = nUppers - 1; iUpper >= 0; iUpper--) {
+            acc = (*this->bCombine)(std::move(acc), uppers[iUpper].get());
+        }
+
+        return acc;
+    }
+};
+
+
+
+/**
+ * Winpool::parallelFor
+ * 
+ * Calls body(i) for every i in [first, last), spread over the workers,
+ * and returns once all calls have returned. The range is split lazily:
+ * a worker only hands half of what's left to thieves when its own 
+ * deque has run empty, so there's no grain size to tune.
+ * 
+ * first: Start of the range (inclusive). An integer or a random access
+ *        iterator.
+ * last: End of the range (exclusive).
+ * body: Callable taking an element of the range. Called concurrently.
+ */
+template<class Index, class F>
+void Winpool::parallelFor(Index first, Index last, F &&body) {
+
+    // A reduction whose pieces have nothing to combine
+    this->parallelReduce(
+        first, 
+        last, 
+        false, 
+        [&body](Index lo, Index hi, bool acc) {
+            for (Index i = lo; i != hi; ++i) {
+                body(i);
+            }
+            return acc;
+        }, 
+        [](bool left, bool right) {
+            return left;
+        }
+    );
+}
+
+
+
+/**
+ * Winpool::parallelReduce
+ * 
+ * Reduces [first, last) in parallel, splitting it the same way as 
+ * parallelFor. Each piece is folded by body, starting from identity, and
+ * the pieces' results are combined in range order.
+ * 
+ * first: Start of the range (inclusive). An integer or a random access
+ *        iterator.
+ * last: End of the range (exclusive).
+ * identity: Result of an empty range.
+ * body: Callable taking (lo, hi, acc) that folds [lo, hi) into acc and
+ *       returns the result. Called concurrently.
+ * combine: Associative callable taking the results of two adjacent 
+ *          pieces (left, right) and returning their combination.
+ * 
+ * Return Value: Returns the result for the whole range.
+ */
+template<class Index, class T, class Body, class Combine>
+T Winpool::parallelReduce(Index first, 
+                          Index last, 
+                          T identity, 
+                          Body &&body, 
+                          Combine &&combine) {
+
+    using BodyFn = typename std::remove_reference<Body>::type;
+    using CombineFn = typename std::remove_reference<Combine>::type;
+
+    if (first == last)
+        return identity;
+
+    RangeReducer<Index, T, BodyFn, CombineFn> reducer;
+    reducer.bPool = this;
+    reducer.bIdentity = &identity;
+    reducer.bBody = &body;
+    reducer.bCombine = &combine;
+
+    // Workers reduce in place, external threads hand the whole range to the
+    // pool and wait
+    if (this->workerTls.get() != nullptr) {
+        return reducer.run(first, last);
+    }
+
+    const RangeReducer<Index, T, BodyFn, CombineFn> *bReducer = &reducer;
+    return this->submit([bReducer, first, last]() {
+        return bReducer->run(first, last);
+    }).get();
+}
+
+} // end WinpoolNS
+
+
+
+#endif // ifndef WINPOOL_TEMPLATES_H
@@ -0,0 +1,24 @@
+
+/**
+ * BlockingRegion.BlockingRegion.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * BlockingRegion constructor
+ * 
+ * bPool: Pool whose worker may be running the calling task.
+ */
+BlockingRegion::BlockingRegion(Winpool *bPool) {
+    this->bPool = bPool;
+    this->counted = bPool->enterBlocking();
+}
@@ -0,0 +1,25 @@
+
+/**
+ * BlockingRegion.~BlockingRegion.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * BlockingRegion destructor
+ * 
+ * Ends the region. Call it on the thread that created it.
+ */
+BlockingRegion::~BlockingRegion() {
+    if (this->counted) {
+        this->bPool->leaveBlocking();
+    }
+}
@@ -0,0 +1,23 @@
+/**
+ * CancelState.CancelState.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * CancelState constructor
+ * 
+ * Creates an uncancelled state with one reference.
+ */
+CancelState::CancelState() {
+    this->nRefs.store(1, std::memory_order_relaxed);
+    this->cancelled.store(false, std::memory_order_relaxed);
+}
@@ -0,0 +1,22 @@
+/**
+ * CancelState.addRef.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * CancelState::addRef
+ * 
+ * Takes another reference.
+ */
+void CancelState::addRef() {
+    this->nRefs.fetch_add(1, std::memory_order_relaxed);
+}
@@ -0,0 +1,24 @@
+/**
+ * CancelState.release.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * CancelState::release
+ * 
+ * Drops one reference, deleting the state if it was the last one.
+ */
+void CancelState::release() {
+    if (this->nRefs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        delete this;
+    }
+}
@@ -0,0 +1,36 @@
+/**
+ * CancelToken.CancelToken.cxx
+ * 
+ * Contains definitions for CancelToken constructors.
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * CancelToken constructor
+ * 
+ * Creates a new, uncancelled token.
+ */
+CancelToken::CancelToken() {
+    this->state = new CancelState();
+}
+
+
+
+/**
+ * CancelToken copy constructor
+ * 
+ * Makes another handle to the same token.
+ */
+CancelToken::CancelToken(const CancelToken &other) {
+    this->state = other.state;
+    this->state->addRef();
+}
@@ -0,0 +1,22 @@
+/**
+ * CancelToken.cancel.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * CancelToken::cancel
+ * 
+ * Cancels the token. Any thread may call this, any number of times.
+ */
+void CancelToken::cancel() {
+    this->state->cancelled.store(true, std::memory_order_relaxed);
+}
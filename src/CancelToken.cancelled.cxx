@@ -0,0 +1,22 @@
+/**
+ * CancelToken.cancelled.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * CancelToken::cancelled
+ * 
+ * Return Value: Returns true once the token has been cancelled.
+ */
+bool CancelToken::cancelled() const {
+    return this->state->cancelled.load(std::memory_order_relaxed);
+}
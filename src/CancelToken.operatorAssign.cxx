@@ -0,0 +1,28 @@
+/**
+ * CancelToken.operatorAssign.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * CancelToken copy assignment
+ * 
+ * Lets go of this handle's token and shares other's.
+ */
+CancelToken &CancelToken::operator=(const CancelToken &other) {
+
+    // Taken first, so assigning a token to itself doesn't free it
+    other.state->addRef();
+    this->state->release();
+    this->state = other.state;
+
+    return *this;
+}
@@ -0,0 +1,20 @@
+/**
+ * CancelToken.~CancelToken.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * CancelToken destructor
+ */
+CancelToken::~CancelToken() {
+    this->state->release();
+}
@@ -0,0 +1,25 @@
+
+/**
+ * CondVar.CondVar.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * CondVar constructor
+ */
+CondVar::CondVar() {
+#ifdef _WIN32
+    InitializeConditionVariable(&this->cv);
+#else
+    this->seq.store(0, std::memory_order_relaxed);
+#endif
+}
@@ -0,0 +1,39 @@
+
+/**
+ * CondVar.wait.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * CondVar::wait
+ *
+ * Atomically releases lock and sleeps until woken, then reacquires lock
+ * before returning. Wakeups may be spurious.
+ * Throws a SyscallError if the wait fails.
+ *
+ * lock: Lock held by the calling thread.
+ */
+void CondVar::wait(Lock *lock) {
+#ifdef _WIN32
+    BOOL boolRc = SleepConditionVariableCS(&this->cv, &lock->cs, INFINITE);
+    if (!boolRc) {
+        throw SyscallError(lastErrorCode());
+    }
+#else
+    // Any wake issued after we read seq changes it, so waitOnAddress won't 
+    // sleep through a wake that happens between leave() and the wait.
+    uint32_t seq = this->seq.load(std::memory_order_relaxed);
+    lock->leave();
+    waitOnAddress(&this->seq, seq);
+    lock->enter();
+#endif
+}
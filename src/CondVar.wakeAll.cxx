@@ -0,0 +1,28 @@
+
+/**
+ * CondVar.wakeAll.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * CondVar::wakeAll
+ *
+ * Wakes up all threads sleeping on this condition variable.
+ */
+void CondVar::wakeAll() {
+#ifdef _WIN32
+    WakeAllConditionVariable(&this->cv);
+#else
+    this->seq.fetch_add(1, std::memory_order_relaxed);
+    wakeAddressAll(&this->seq);
+#endif
+}
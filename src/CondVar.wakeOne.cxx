@@ -0,0 +1,28 @@
+
+/**
+ * CondVar.wakeOne.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * CondVar::wakeOne
+ *
+ * Wakes up at most one thread sleeping on this condition variable.
+ */
+void CondVar::wakeOne() {
+#ifdef _WIN32
+    WakeConditionVariable(&this->cv);
+#else
+    this->seq.fetch_add(1, std::memory_order_relaxed);
+    wakeAddressOne(&this->seq);
+#endif
+}
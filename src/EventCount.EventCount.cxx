@@ -0,0 +1,22 @@
+
+/**
+ * EventCount.EventCount.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * EventCount constructor
+ */
+EventCount::EventCount() {
+    this->epoch.store(0, std::memory_order_relaxed);
+    this->nWaiters.store(0, std::memory_order_relaxed);
+}
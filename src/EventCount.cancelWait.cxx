@@ -0,0 +1,23 @@
+
+/**
+ * EventCount.cancelWait.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * EventCount::cancelWait
+ * 
+ * Unregisters a waiter that found work after prepareWait.
+ */
+void EventCount::cancelWait() {
+    this->nWaiters.fetch_sub(1, std::memory_order_relaxed);
+}
@@ -0,0 +1,31 @@
+
+/**
+ * EventCount.notifyAll.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * EventCount::notifyAll
+ * 
+ * Wakes up all waiters.
+ */
+void EventCount::notifyAll() {
+
+    // Order the caller's publish before the nWaiters check
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (this->nWaiters.load(std::memory_order_relaxed) == 0)
+        return;
+
+    this->epoch.fetch_add(1, std::memory_order_release);
+    wakeAddressAll(&this->epoch);
+}
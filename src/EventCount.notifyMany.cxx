@@ -0,0 +1,41 @@
+/**
+ * EventCount.notifyMany.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * EventCount::notifyMany
+ * 
+ * Wakes up to n waiters. Like notifyOne, costs nothing when nobody is 
+ * waiting.
+ * 
+ * n: Number of waiters to wake.
+ */
+void EventCount::notifyMany(uint32_t n) {
+
+    // Order the caller's publish of new work before the nWaiters check
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    uint32_t nWaiting = this->nWaiters.load(std::memory_order_relaxed);
+    if (nWaiting == 0 || n == 0)
+        return;
+
+    this->epoch.fetch_add(1, std::memory_order_release);
+    if (n >= nWaiting) {
+        wakeAddressAll(&this->epoch);
+    }
+    else {
+        for (uint32_t i = 0; i < n; i++) {
+            wakeAddressOne(&this->epoch);
+        }
+    }
+}
@@ -0,0 +1,32 @@
+
+/**
+ * EventCount.notifyOne.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * EventCount::notifyOne
+ * 
+ * Wakes up one waiter, if there are any. Costs no syscall and no atomic
+ * read-modify-write when nobody is waiting.
+ */
+void EventCount::notifyOne() {
+
+    // Order the caller's publish of new work before the nWaiters check
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (this->nWaiters.load(std::memory_order_relaxed) == 0)
+        return;
+
+    this->epoch.fetch_add(1, std::memory_order_release);
+    wakeAddressOne(&this->epoch);
+}
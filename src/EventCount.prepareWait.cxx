@@ -0,0 +1,30 @@
+
+/**
+ * EventCount.prepareWait.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * EventCount::prepareWait
+ * 
+ * Registers the calling thread as a waiter. The caller must check for 
+ * work again after this and then call wait or cancelWait.
+ * 
+ * Return Value: Returns the key to pass to wait.
+ */
+uint32_t EventCount::prepareWait() {
+
+    // seq_cst pairs with the fence in notify: either the notifier sees us 
+    // in nWaiters, or our re-check for work sees what it published
+    this->nWaiters.fetch_add(1, std::memory_order_seq_cst);
+    return this->epoch.load(std::memory_order_seq_cst);
+}
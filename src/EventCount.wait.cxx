@@ -0,0 +1,31 @@
+
+/**
+ * EventCount.wait.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * EventCount::wait
+ * 
+ * Sleeps until a notify happens after the prepareWait that returned key,
+ * then unregisters the waiter. Returns immediately if one already did.
+ * 
+ * key: Value returned by prepareWait.
+ */
+void EventCount::wait(uint32_t key) {
+
+    while (this->epoch.load(std::memory_order_acquire) == key) {
+        waitOnAddress(&this->epoch, key);
+    }
+
+    this->nWaiters.fetch_sub(1, std::memory_order_relaxed);
+}
@@ -0,0 +1,35 @@
+/**
+ * EventCount.waitFor.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * EventCount::waitFor
+ * 
+ * Like wait, but gives up once timeoutNs nanoseconds have passed.
+ * 
+ * key: Value returned by prepareWait.
+ * timeoutNs: Longest time to sleep for.
+ */
+void EventCount::waitFor(uint32_t key, uint64_t timeoutNs) {
+
+    uint64_t deadlineNs = monotonicNs() + timeoutNs;
+
+    while (this->epoch.load(std::memory_order_acquire) == key) {
+        uint64_t nowNs = monotonicNs();
+        if (nowNs >= deadlineNs)
+            break;
+        waitOnAddressFor(&this->epoch, key, deadlineNs - nowNs);
+    }
+
+    this->nWaiters.fetch_sub(1, std::memory_order_relaxed);
+}
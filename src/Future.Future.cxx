@@ -7,7 +7,6 @@
 
 
 
-#include <windows.h>
 #include <memory>
 #include "_winpool_private.hxx"
 
@@ -19,21 +18,51 @@ using namespace WinpoolNS;
 
 /**
  * Future constructor
+ * 
+ * func: Task to execute.
+ * arg: Argument to pass to func.
+ * bPool: Borrowed pointer to the pool.
+ * owner: Borrowed pointer to the FutureOwner that protects this Future.
  */
 Future::Future(WinpoolTask func, 
                void *arg, 
                Winpool *bPool,
-               FutureOwner *owner) {
+               FutureOwner *owner) :
+        Future(bPool) {
     
-    this->status = QUEUED;
-    this->func = func;
     this->arg = arg;
     this->owner = owner;
-    this->lock = &owner->lock;
+    this->setTask([func = std::move(func), arg]() { return func(arg); });
+}
+
+
+
+/**
+ * Future task-less constructor
+ * 
+ * Creates a Future with no task and no owner. Give it a task with setTask
+ * and pass it to Winpool::submitFuture.
+ * 
+ * bPool: Borrowed pointer to the pool.
+ */
+Future::Future(Winpool *bPool) {
+
+    this->nRefs.store(2, std::memory_order_relaxed);
+    this->status.store(QUEUED, std::memory_order_relaxed);
+    this->nWaiters.store(0, std::memory_order_relaxed);
+    this->queueNext.store(nullptr, std::memory_order_relaxed);
+    this->continuations.store(nullptr, std::memory_order_relaxed);
+    this->detached = false;
+    this->priority = PRIORITY_NORMAL;
+    this->cancellable = false;
+    this->cancelled = false;
+    this->token = nullptr;
+    this->arg = nullptr;
+    this->owner = nullptr;
     this->executor = nullptr;
     this->bPool = bPool;
-
-    InitializeConditionVariable(&this->condCompleted);
+    this->invokeTask = nullptr;
+    this->destroyTask = nullptr;
 }
 
 
@@ -44,6 +73,17 @@ Future::Future(WinpoolTask func,
  * Creates an empty Future list with 2 sentinel nodes linked to each other.
  */
 Future::Future(bool sentinel) {
-    status = SENTINEL;
+    this->nRefs.store(1, std::memory_order_relaxed);
+    this->status.store(SENTINEL, std::memory_order_relaxed);
+    this->nWaiters.store(0, std::memory_order_relaxed);
+    this->queueNext.store(nullptr, std::memory_order_relaxed);
+    this->continuations.store(nullptr, std::memory_order_relaxed);
+    this->detached = false;
+    this->priority = PRIORITY_NORMAL;
+    this->cancellable = false;
+    this->cancelled = false;
+    this->token = nullptr;
     this->arg = (void *)15042;
+    this->invokeTask = nullptr;
+    this->destroyTask = nullptr;
 }
@@ -0,0 +1,44 @@
+
+/**
+ * Future.addContinuation.cxx
+ */
+
+
+
+#include <memory>
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * Future::addContinuation
+ * 
+ * Submits cont to its pool once this Future is DONE - right away if it 
+ * already is. Nobody blocks in the meantime.
+ * 
+ * cont: Future with its task set, with ownership passed to this function.
+ */
+void Future::addContinuation(UniquePtr<Future> cont) {
+
+    Future *bCont = cont.get();
+    Future *head = this->continuations.load(std::memory_order_acquire);
+
+    // Push onto the list unless executeFuture has already closed it 
+    while (head != this) {
+        bCont->queueNext.store(head, std::memory_order_relaxed);
+        if (this->continuations.compare_exchange_weak(
+                head, 
+                bCont, 
+                std::memory_order_release, 
+                std::memory_order_acquire)) {
+            cont.release();
+            return;
+        }
+    }
+
+    bCont->bPool->submitFuture(std::move(cont));
+}
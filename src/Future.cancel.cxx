@@ -0,0 +1,36 @@
+/**
+ * Future.cancel.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * Future::cancel
+ * 
+ * Stops a cancellable task that hasn't started from ever running. Its 
+ * Future still completes (as cancelled) when the task would have run:
+ * queues can't unlink it from the middle, so whoever pops it skips it.
+ * 
+ * Return Value: Returns true if the task was cancellable and QUEUED.
+ */
+bool Future::cancel() {
+
+    if (!this->cancellable)
+        return false;
+
+    // The executor exchanges in RUNNING: exactly one of us wins
+    uint32_t expected = QUEUED;
+    return this->status.compare_exchange_strong(
+        expected, 
+        CANCELLED, 
+        std::memory_order_acq_rel
+    );
+}
@@ -7,7 +7,6 @@
 
 #include <cstdio>
 #include <memory>
-#include <windows.h>
 #include "_winpool_private.hxx"
 
 
@@ -19,40 +18,31 @@ using namespace WinpoolNS;
 /**
  * Future::externalGet
  * 
- * Helper function for Future::get - only called by external (non-worker) 
- * threads.
- * Blocks the calling thread until the Future is DONE.DONE
- * 
- * newOwner: Ownership of this Future will be passed here if it's not
- *           nullptr.
+ * Helper function for Future::join - only called by external 
+ * (non-worker) threads.
+ * Blocks the calling thread until the Future is DONE. Doesn't block or take
+ * a lock to find out it already is.
  * 
  * Return Value: Returns the result returned by this Future's task.
  */
-void *Future::externalGet(UniquePtr<Future> *newOwner) {
-
-    BOOL boolRc;
-
-    EnterCriticalSection(this->lock);
-
-    if (this->status != DONE) {
-        boolRc = SleepConditionVariableCS(
-            &this->condCompleted, 
-            this->lock, 
-            INFINITE
-        );
-        if (!boolRc) {
-            std::fprintf(stderr, "Future::externalGet sleep failed\n");
-            std::fflush(stderr);
-            throw SyscallError(GetLastError());
-        }
-    }
+void *Future::externalGet() {
+
+    if (this->status.load(std::memory_order_acquire) != DONE) {
 
-    void *res = this->res;
-    UniquePtr<Future> uThis = this->popFromList();
-    if (newOwner != nullptr)
-        *newOwner = std::move(uThis);
+        // seq_cst pairs with the fence in executeFuture: either the executor
+        // sees us in nWaiters, or we see DONE below
+        this->nWaiters.fetch_add(1, std::memory_order_seq_cst);
 
-    LeaveCriticalSection(this->lock);
+        // Wakeups may be spurious, so keep checking
+        uint32_t curStatus;
+        while ((curStatus = this->status.load(std::memory_order_seq_cst)) 
+                != DONE) {
+            waitOnAddress(&this->status, curStatus);
+        }
+
+        this->nWaiters.fetch_sub(1, std::memory_order_relaxed);
+    }
 
-    return res;
+    // The acquire load above makes res visible
+    return this->res;
 }
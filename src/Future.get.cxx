@@ -24,19 +24,26 @@ using namespace WinpoolNS;
  * 
  * newOwner: If not nullptr, a UniquePtr holding ownership of this Future
  *           will be placed at newOwner.
- *           If nullptr, this Future will be discarded after this call 
- *           returns.
+ *           If nullptr, the handle's reference is dropped and this Future
+ *           will be discarded once the pool is done with it.
  * 
  * Return Value: Returns the result returned by this Future's task.
  */
 void *Future::get(UniquePtr<Future> *newOwner) {
 
-    Worker *bpMyWorker = (Worker *)TlsGetValue(this->bPool->workerTlsIdx);
+    void *res = this->join();
 
-    if (bpMyWorker == nullptr) {
-        return this->externalGet(newOwner);
+    if (newOwner == nullptr) {
+        this->release();
+        return res;
     }
-    else {
-        return this->workerGet(newOwner, bpMyWorker);
+
+    // The executor may still be waking up waiters: wait for it to drop the
+    // pool's reference before handing out sole ownership
+    while (this->nRefs.load(std::memory_order_acquire) != 1) {
+        yieldThread();
     }
+    *newOwner = UniquePtr<Future>(this);
+
+    return res;
 }
@@ -0,0 +1,34 @@
+
+/**
+ * Future.join.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * Future::join
+ * 
+ * Waits until this Future is DONE, like get, but keeps the handle's 
+ * reference: call release once done with the result.
+ * 
+ * Return Value: Returns the result returned by this Future's task.
+ */
+void *Future::join() {
+
+    Worker *bMyWorker = (Worker *)this->bPool->workerTls.get();
+
+    if (bMyWorker == nullptr) {
+        return this->externalGet();
+    }
+    else {
+        return this->workerGet(bMyWorker);
+    }
+}
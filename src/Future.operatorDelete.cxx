@@ -0,0 +1,38 @@
+
+/**
+ * Future.operatorDelete.cxx
+ */
+
+
+
+#include <new>
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * Future operator delete
+ * 
+ * Returns a Future's memory to wherever it was allocated from. Safe to 
+ * call on any thread.
+ */
+void Future::operator delete(void *ptr) {
+
+    if (ptr == nullptr)
+        return;
+
+    FutureSlabBlock *block = (FutureSlabBlock *)ptr - 1;
+    if (block->batch != nullptr) {
+        block->batch->release();
+    }
+    else if (block->home == nullptr) {
+        ::operator delete((void *)block);
+    }
+    else {
+        block->home->free(block);
+    }
+}
@@ -0,0 +1,39 @@
+
+/**
+ * Future.operatorNew.cxx
+ */
+
+
+
+#include <new>
+#include <cassert>
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * Future operator new
+ * 
+ * Allocates Futures from the calling worker's FutureSlab, or from the 
+ * global heap on external threads.
+ */
+void *Future::operator new(size_t size) {
+
+    assert(size == sizeof(Future));
+
+    FutureSlab *slab = FutureSlab::tlsMySlab;
+    if (slab != nullptr) {
+        return slab->alloc();
+    }
+
+    FutureSlabBlock *block = (FutureSlabBlock *)::operator new(
+        sizeof(FutureSlabBlock) + size
+    );
+    block->home = nullptr;
+    block->batch = nullptr;
+    return (void *)(block + 1);
+}
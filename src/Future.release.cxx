@@ -0,0 +1,26 @@
+
+/**
+ * Future.release.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * Future::release
+ * 
+ * Drops a reference, deleting this Future after the last one. Call it 
+ * instead of get to give up on a result; the task still runs.
+ */
+void Future::release() {
+    if (this->nRefs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        delete this;
+    }
+}
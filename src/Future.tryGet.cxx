@@ -0,0 +1,34 @@
+/**
+ * Future.tryGet.cxx
+ */
+
+
+
+#include <memory>
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * Future::tryGet
+ * 
+ * Like get(nullptr) if this Future is DONE; otherwise returns right 
+ * away, keeping the handle. Never blocks or takes a lock.
+ * 
+ * res: Where to put the result returned by the task.
+ * 
+ * Return Value: Returns true if the task was done and res was set.
+ */
+bool Future::tryGet(void **res) {
+
+    if (this->status.load(std::memory_order_acquire) != DONE)
+        return false;
+
+    // Done: get won't wait
+    *res = this->get(nullptr);
+    return true;
+}
@@ -0,0 +1,34 @@
+/**
+ * Future.waitFor.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * Future::waitFor
+ * 
+ * Like waitUntil, giving up after timeoutNs nanoseconds.
+ * 
+ * timeoutNs: Longest time to wait for.
+ * 
+ * Return Value: Returns true if this Future is DONE.
+ */
+bool Future::waitFor(uint64_t timeoutNs) {
+
+    if (this->status.load(std::memory_order_acquire) == DONE)
+        return true;
+
+    uint64_t nowNs = monotonicNs();
+    uint64_t deadlineNs = timeoutNs > UINT64_MAX - nowNs 
+                          ? UINT64_MAX 
+                          : nowNs + timeoutNs;
+    return this->waitUntil(deadlineNs);
+}
@@ -0,0 +1,55 @@
+/**
+ * Future.waitUntil.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * Future::waitUntil
+ * 
+ * Blocks the calling thread until this Future is DONE or deadlineNs 
+ * has passed, whichever comes first. Keeps the handle either way. Once 
+ * the deadline has passed this is a load and a clock read: cheap 
+ * enough to poll. Unlike get, a worker thread doesn't help with other
+ * tasks meanwhile, so keep waits short there.
+ * 
+ * deadlineNs: Time to give up at, on the monotonicNs clock.
+ * 
+ * Return Value: Returns true if this Future is DONE.
+ */
+bool Future::waitUntil(uint64_t deadlineNs) {
+
+    if (this->status.load(std::memory_order_acquire) == DONE)
+        return true;
+
+    // Expired: don't even register as a waiter
+    uint64_t nowNs = monotonicNs();
+    if (nowNs >= deadlineNs)
+        return false;
+
+    // Same handshake as externalGet: seq_cst pairs with the fence in 
+    // executeFuture, so either the executor sees us in nWaiters or we see
+    // DONE below. Timeouts and spurious wakeups both just loop.
+    this->nWaiters.fetch_add(1, std::memory_order_seq_cst);
+
+    uint32_t curStatus;
+    while ((curStatus = this->status.load(std::memory_order_seq_cst)) 
+            != DONE && 
+           nowNs < deadlineNs) {
+        waitOnAddressFor(&this->status, curStatus, deadlineNs - nowNs);
+        nowNs = monotonicNs();
+    }
+
+    this->nWaiters.fetch_sub(1, std::memory_order_relaxed);
+
+    // The seq_cst load that saw DONE makes res visible
+    return curStatus == DONE;
+}
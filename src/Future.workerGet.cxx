@@ -6,7 +6,6 @@
 
 
 #include <memory>
-#include <windows.h>
 #include <assert.h>
 #include "_winpool_private.hxx"
 
@@ -19,90 +18,133 @@ using namespace WinpoolNS;
 /**
  * Future::workerGet
  * 
- * Helper function for Future::get - only called by worker threads.
- * If this Future is QUEUED, just executes it in the calling thread.
- * If this Future is RUNNING, helps the thread executing it until it 
- * is done.
- * If this Future is DONE, just returns the result.
+ * Helper function for Future::join - only called by worker threads.
+ * If this Future is QUEUED or RUNNING, executes other tasks until it is
+ * done: from the queue holding it, from its executor, from whoever its
+ * executor is joining (and so on down the chain), then from anywhere.
+ * If this Future is DONE, just returns the result. Checking the status
+ * doesn't take a lock.
  * 
- * newOwner: Ownership of this Future will be passed here if it's not 
- *           nullptr.
  * bMyWorker: Borrowed pointer to the Worker instance for the calling 
  *            thread.
  * 
  * Return Value: Returns the result returned by this Future's task.
  */
-void *Future::workerGet(UniquePtr<Future> *newOwner, Worker *bMyWorker) {
-
-    UniquePtr<Future> uThis;
-    void *res;
-
-    EnterCriticalSection(this->lock);
-
-    // The task hasn't started, execute it yourself
-    if (this->status == QUEUED) {
-        this->status = RUNNING;
-        this->executor = bMyWorker;
-        uThis = this->popFromList();
-        LeaveCriticalSection(this->lock);
-
-        res = this->func(this->arg);
-        
-        EnterCriticalSection(this->lock);
-        this->res = res;
-        this->status = DONE;
-        //this->owner->completedList.insertTail(std::move(uThis));
-        if (newOwner != nullptr) 
-            *newOwner = std::move(uThis);
-        WakeAllConditionVariable(&this->condCompleted);
-        LeaveCriticalSection(this->lock);
-        return res;
-    }
-
-    // The task is running, help the worker that is executing it.
-    while (this->status == RUNNING) {
-
-        // The executor should never be the worker of the calling thread 
-        assert(this->executor != bMyWorker);
-
-        EnterCriticalSection(&this->executor->lock);
-
-        // Executor has task available: steal and execute it
-        if (!this->executor->taskQueue.empty()) {
-            UniquePtr<Future> helpFut = this->executor->taskQueue.popTail();
-            assert(helpFut != nullptr);
-            Future *bHelpFut = helpFut.get();
-            helpFut->status = RUNNING;
-            helpFut->executor = bMyWorker;
-            LeaveCriticalSection(&this->executor->lock);
-            LeaveCriticalSection(this->lock);
-
-            res = helpFut->func(helpFut->arg);
-
-            EnterCriticalSection(helpFut->lock);
-            helpFut->res = res;
-            helpFut->status = DONE;
-            helpFut->owner->completedList.insertTail(std::move(helpFut));
-            WakeAllConditionVariable(&bHelpFut->condCompleted);
-            LeaveCriticalSection(bHelpFut->lock);
+void *Future::workerGet(Worker *bMyWorker) {
+
+    uint32_t curStatus = this->status.load(std::memory_order_acquire);
+    if (curStatus != DONE) {
+
+        Winpool *bPool = this->bPool;
+        int nWorkers = bPool->nWorkers;
+
+        // We may be joining from inside a task we picked up while joining
+        // something else: put that join's victim back when we're done
+        Worker *bPrevVictim = 
+            bMyWorker->joinVictim.load(std::memory_order_relaxed);
+
+        uint64_t nHelps = 0;
+        uint64_t nStealAttempts = 0;
+        uint64_t nSteals = 0;
+        uint64_t nQueuePops = 0;
+        uint64_t wastedNs = 0;
+        uint64_t idleSinceNs = 0;
+        uint64_t joinStartNs = monotonicNs();
+        bMyWorker->joinDepth++;
+
+        // A queued task can't be pulled out of the middle of a queue, so 
+        // until it is done, help. Work derived from it comes first: our own
+        // deque if the task is in it (it gets popped eventually), the pool's
+        // queue if it was submitted externally, otherwise the deque of the 
+        // worker that has it. If that worker is itself joining, its victim's
+        // deque holds the work it waits for, and so on (leapfrogging).
+        // Failing all that, any task keeps us busy.
+        do {
+
+            // The executor should never be the worker of the calling thread 
+            assert(curStatus != RUNNING || this->executor != bMyWorker);
+
+            Worker *bVictim = curStatus == RUNNING 
+                              ? this->executor 
+                              : this->owner;
+            UniquePtr<Future> helpFut;
+
+            if (curStatus == RUNNING) {
+                bMyWorker->joinVictim.store(
+                    bVictim, 
+                    std::memory_order_relaxed
+                );
+            }
+
+            if (bVictim == bMyWorker) {
+                helpFut = bMyWorker->taskQueue.pop();
+            }
+            else if (bVictim == &bPool->futures) {
+                helpFut = bPool->taskQueue.pop(bMyWorker->nextRandom());
+                nQueuePops += helpFut != nullptr;
+            }
+            else {
+                // Follow the chain of joiners; it can't be longer than the
+                // number of workers unless it's a stale loop
+                for (int iHop = 0; 
+                     iHop < nWorkers && 
+                         bVictim != nullptr && 
+                         bVictim != bMyWorker && 
+                         helpFut == nullptr; 
+                     iHop++) {
+                    if (!bVictim->taskQueue.empty()) {
+                        nStealAttempts++;
+                        helpFut = bVictim->taskQueue.steal();
+                        nSteals += helpFut != nullptr;
+                    }
+                    bVictim = 
+                        bVictim->joinVictim.load(std::memory_order_relaxed);
+                }
+            }
+
+            if (helpFut == nullptr) {
+                helpFut = findTask(bPool, bMyWorker);
+            }
+
+            // Found a task: execute it
+            if (helpFut != nullptr) {
+                if (idleSinceNs != 0) {
+                    wastedNs += monotonicNs() - idleSinceNs;
+                    idleSinceNs = 0;
+                }
+                nHelps++;
+                executeFuture(std::move(helpFut), bMyWorker);
+            }
+            // Nothing to help with anywhere: yield and check later
+            else {
+                if (idleSinceNs == 0) {
+                    idleSinceNs = monotonicNs();
+                }
+                yieldThread();
+            }
+
+        } while ((curStatus = this->status.load(std::memory_order_acquire)) 
+                 != DONE);
+
+        uint64_t joinEndNs = monotonicNs();
+        if (idleSinceNs != 0) {
+            wastedNs += joinEndNs - idleSinceNs;
         }
 
-        // Executor doesn't have any subtasks: yield and check later
-        else {
-            LeaveCriticalSection(&this->executor->lock);
-            LeaveCriticalSection(this->lock);
-            Sleep(0); // This yields this thread's time slice
+        bMyWorker->joinVictim.store(bPrevVictim, std::memory_order_relaxed);
+
+        // Only our own thread writes the counters: no read-modify-write
+        bumpCounter(&bMyWorker->nJoinWaits, (uint64_t)1);
+        bumpCounter(&bMyWorker->nJoinHelps, nHelps);
+        bumpCounter(&bMyWorker->joinWastedNs, wastedNs);
+        if (--bMyWorker->joinDepth == 0) {
+            bumpCounter(&bMyWorker->joinNs, joinEndNs - joinStartNs);
         }
-        
-        EnterCriticalSection(this->lock);
+        bumpCounter(&bMyWorker->nStealAttempts, nStealAttempts);
+        bumpCounter(&bMyWorker->nSteals, nSteals);
+        bumpCounter(&bMyWorker->nQueuePops, nQueuePops);
     }
 
-    // At this point, we know that our task has completed and is on a 
-    // completedList
-    res = this->res;
-    uThis = this->popFromList();
-    LeaveCriticalSection(this->lock);
-    if (newOwner != nullptr)
-        *newOwner = std::move(uThis);
-    return res;
+    // The acquire load above makes res visible
+    return this->res;
 }
@@ -17,6 +17,24 @@
  * Future destructor
  */
 WinpoolNS::Future::~Future() {
+
+    // Continuations of a task that never completed never will be submitted
+    Future *bCont = this->continuations.load(std::memory_order_relaxed);
+    while (bCont != nullptr && bCont != this) {
+        Future *bNext = bCont->queueNext.load(std::memory_order_relaxed);
+        delete bCont;
+        bCont = bNext;
+    }
+
+    // The task never ran (or threw) - its callable is still alive
+    if (this->destroyTask != nullptr) {
+        this->destroyTask(this);
+    }
+
+    if (this->token != nullptr) {
+        this->token->release();
+    }
+
     /*
     std::printf(
         "Future(arg=%p) being destroyed...\n",
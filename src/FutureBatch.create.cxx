@@ -0,0 +1,65 @@
+/**
+ * FutureBatch.create.cxx
+ */
+
+
+
+#include <cstdlib>
+#include <new>
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/* roundUp64: Rounds size up to a multiple of 64 bytes. */
+static size_t roundUp64(size_t size) {
+    return (size + 63) & ~(size_t)63;
+}
+
+
+
+/**
+ * FutureBatch::create
+ * 
+ * Allocates a batch with room for nTasks Futures and a funcSize byte
+ * (64 byte aligned) callable.
+ * Throws std::bad_alloc if there isn't enough memory.
+ * 
+ * bPool: Borrowed pointer to the pool the batch will be submitted to.
+ * nTasks: Number of tasks in the batch.
+ * funcSize: Size of the callable the tasks share.
+ * 
+ * Return Value: Returns a borrowed pointer to the new batch, which frees
+ *               itself once its Futures and the TaskBatch handle are gone.
+ */
+FutureBatch *FutureBatch::create(Winpool *bPool, 
+                                 uint32_t nTasks, 
+                                 size_t funcSize) {
+
+    // [header][callable][block 0]...[block nTasks - 1], each part padded to
+    // a multiple of 64 bytes like the slab's chunks
+    size_t headerSize = roundUp64(sizeof(FutureBatch));
+    size_t funcRegionSize = roundUp64(funcSize);
+    size_t totalSize = headerSize + funcRegionSize 
+                     + (size_t)nTasks * futureBlockSize;
+
+    char *mem = (char *)std::malloc(totalSize);
+    if (mem == nullptr) {
+        throw std::bad_alloc();
+    }
+
+    FutureBatch *batch = ::new (mem) FutureBatch();
+    batch->bPool = bPool;
+    batch->nTasks = nTasks;
+    batch->nRefs.store((int64_t)nTasks + 1, std::memory_order_relaxed);
+    batch->nPending.store(nTasks, std::memory_order_relaxed);
+    batch->nWaiters.store(0, std::memory_order_relaxed);
+    batch->funcStorage = mem + headerSize;
+    batch->destroyFunc = nullptr;
+    batch->futureBlocks = mem + headerSize + funcRegionSize;
+
+    return batch;
+}
@@ -0,0 +1,32 @@
+/**
+ * FutureBatch.finishTask.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * FutureBatch::finishTask
+ * 
+ * Called by each task once it has run. Wakes up joiners after the last 
+ * one.
+ */
+void FutureBatch::finishTask() {
+
+    if (this->nPending.fetch_sub(1, std::memory_order_acq_rel) != 1)
+        return;
+
+    // Order the final decrement before the nWaiters check, pairs with the
+    // seq_cst increment in FutureBatch::join
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (this->nWaiters.load(std::memory_order_relaxed) != 0) {
+        wakeAddressAll(&this->nPending);
+    }
+}
@@ -0,0 +1,24 @@
+/**
+ * FutureBatch.futureAt.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * FutureBatch::futureAt
+ * 
+ * Return Value: Returns a pointer to the iTask-th Future of the batch.
+ */
+Future *FutureBatch::futureAt(uint32_t iTask) {
+    FutureSlabBlock *block = 
+        (FutureSlabBlock *)(this->futureBlocks + iTask * futureBlockSize);
+    return (Future *)(block + 1);
+}
@@ -0,0 +1,53 @@
+/**
+ * FutureBatch.join.cxx
+ */
+
+
+
+#include <memory>
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * FutureBatch::join
+ * 
+ * Waits until nPending reaches 0. Worker threads run other tasks 
+ * meanwhile, external threads sleep.
+ */
+void FutureBatch::join() {
+
+    if (this->nPending.load(std::memory_order_acquire) == 0)
+        return;
+
+    Winpool *bPool = this->bPool;
+    Worker *myWorker = (Worker *)bPool->workerTls.get();
+
+    // Worker: the batch's tasks are most likely on our own deque, so keep
+    // running whatever we find until they're all done
+    if (myWorker != nullptr) {
+        while (this->nPending.load(std::memory_order_acquire) != 0) {
+            UniquePtr<Future> fut = findTask(bPool, myWorker);
+            if (fut != nullptr)
+                executeFuture(std::move(fut), myWorker);
+            else
+                yieldThread();
+        }
+        return;
+    }
+
+    // External thread: sleep on nPending. seq_cst pairs with the fence in 
+    // FutureBatch::finishTask.
+    this->nWaiters.fetch_add(1, std::memory_order_seq_cst);
+
+    uint32_t nPending;
+    while ((nPending = this->nPending.load(std::memory_order_seq_cst)) != 0) {
+        waitOnAddress(&this->nPending, nPending);
+    }
+
+    this->nWaiters.fetch_sub(1, std::memory_order_relaxed);
+}
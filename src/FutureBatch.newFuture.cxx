@@ -0,0 +1,39 @@
+/**
+ * FutureBatch.newFuture.cxx
+ */
+
+
+
+#include <new>
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * FutureBatch::newFuture
+ * 
+ * Constructs the iTask-th Future of the batch in its block, with no task
+ * yet.
+ * 
+ * Return Value: Returns a pointer to the Future. It is owned by whoever 
+ *               it is handed to like any other Future.
+ */
+Future *FutureBatch::newFuture(uint32_t iTask) {
+
+    FutureSlabBlock *block = 
+        (FutureSlabBlock *)(this->futureBlocks + iTask * futureBlockSize);
+    block->home = nullptr;
+    block->next = nullptr;
+    block->batch = this;
+
+    // Placement new skips Future::operator new; operator delete sees the 
+    // batch in the header and drops a reference instead of freeing
+    Future *fut = ::new ((void *)(block + 1)) Future(this->bPool);
+    fut->detached = true;
+    fut->nRefs.store(1, std::memory_order_relaxed);
+    return fut;
+}
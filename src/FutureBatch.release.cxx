@@ -0,0 +1,31 @@
+/**
+ * FutureBatch.release.cxx
+ */
+
+
+
+#include <cstdlib>
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * FutureBatch::release
+ * 
+ * Drops a reference, freeing the batch after the last one.
+ */
+void FutureBatch::release() {
+
+    if (this->nRefs.fetch_sub(1, std::memory_order_acq_rel) != 1)
+        return;
+
+    if (this->destroyFunc != nullptr) {
+        this->destroyFunc(this->funcStorage);
+    }
+    this->~FutureBatch();
+    std::free((void *)this);
+}
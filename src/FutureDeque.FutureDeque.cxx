@@ -0,0 +1,35 @@
+
+/**
+ * FutureDeque.FutureDeque.cxx
+ * 
+ * Contains definitions for the FutureDeque constructors.
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/* initialCapacity: Number of slots in a new deque's buffer. */
+static const int64_t initialCapacity = 64;
+
+
+
+/**
+ * FutureDeque constructor
+ * 
+ * Creates an empty deque.
+ */
+FutureDeque::FutureDeque() {
+    this->top.store(0, std::memory_order_relaxed);
+    this->bottom.store(0, std::memory_order_relaxed);
+    this->buffer.store(
+        new FutureDequeBuffer(initialCapacity), 
+        std::memory_order_relaxed
+    );
+}
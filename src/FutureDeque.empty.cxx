@@ -0,0 +1,28 @@
+
+/**
+ * FutureDeque.empty.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * FutureDeque::empty
+ * 
+ * Is there anything in the deque? Only a snapshot when called by anyone
+ * other than the owner.
+ * 
+ * Return Value: Returns true if the deque looked empty.
+ */
+bool FutureDeque::empty() {
+    int64_t b = this->bottom.load(std::memory_order_relaxed);
+    int64_t t = this->top.load(std::memory_order_relaxed);
+    return b <= t;
+}
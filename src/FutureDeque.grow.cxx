@@ -0,0 +1,48 @@
+
+/**
+ * FutureDeque.grow.cxx
+ */
+
+
+
+#include <memory>
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * FutureDeque::grow
+ * 
+ * Replaces the buffer with one twice the size, copying the elements in
+ * [t, b) over. Owner only.
+ * 
+ * t: Current top index.
+ * b: Current bottom index.
+ * 
+ * Return Value: Returns the new buffer.
+ */
+FutureDequeBuffer *FutureDeque::grow(int64_t t, int64_t b) {
+
+    FutureDequeBuffer *oldBuf = this->buffer.load(std::memory_order_relaxed);
+    FutureDequeBuffer *newBuf = new FutureDequeBuffer(oldBuf->capacity * 2);
+
+    for (int64_t i = t; i < b; i++) {
+        newBuf->slots[i & (newBuf->capacity - 1)].store(
+            oldBuf->slots[i & (oldBuf->capacity - 1)].load(
+                std::memory_order_relaxed
+            ),
+            std::memory_order_relaxed
+        );
+    }
+
+    // Thieves that loaded oldBuf may still read from it, so it has to stay
+    // alive as long as the deque does
+    newBuf->retired = UniquePtr<FutureDequeBuffer>(oldBuf);
+    this->buffer.store(newBuf, std::memory_order_release);
+
+    return newBuf;
+}
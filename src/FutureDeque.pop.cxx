@@ -0,0 +1,58 @@
+
+/**
+ * FutureDeque.pop.cxx
+ */
+
+
+
+#include <memory>
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * FutureDeque::pop
+ * 
+ * Removes and returns the newest Future (bottom). Owner only.
+ * 
+ * Return Value: Returns a pointer to the popped Future that owns its 
+ *               memory. Returns nullptr if the deque is empty.
+ */
+UniquePtr<Future> FutureDeque::pop() {
+
+    int64_t b = this->bottom.load(std::memory_order_relaxed) - 1;
+    FutureDequeBuffer *buf = this->buffer.load(std::memory_order_relaxed);
+
+    // Claim the bottom slot before looking at top, so a thief either sees 
+    // the smaller bottom or we see its incremented top
+    this->bottom.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t t = this->top.load(std::memory_order_relaxed);
+
+    // Deque was empty
+    if (t > b) {
+        this->bottom.store(b + 1, std::memory_order_relaxed);
+        return UniquePtr<Future>(nullptr);
+    }
+
+    Future *popped = buf->slots[b & (buf->capacity - 1)].load(
+        std::memory_order_relaxed
+    );
+
+    // Last element: race the thieves for it
+    if (t == b) {
+        if (!this->top.compare_exchange_strong(t, 
+                                               t + 1, 
+                                               std::memory_order_seq_cst,
+                                               std::memory_order_relaxed)) {
+            popped = nullptr;
+        }
+        this->bottom.store(b + 1, std::memory_order_relaxed);
+    }
+
+    return UniquePtr<Future>(popped);
+}
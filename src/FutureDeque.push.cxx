@@ -0,0 +1,43 @@
+
+/**
+ * FutureDeque.push.cxx
+ */
+
+
+
+#include <memory>
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * FutureDeque::push
+ * 
+ * Inserts a Future at the bottom of the deque. Owner only.
+ * 
+ * toPush: Pointer to the Future to insert with ownership passed to this
+ *         function.
+ */
+void FutureDeque::push(UniquePtr<Future> toPush) {
+
+    int64_t b = this->bottom.load(std::memory_order_relaxed);
+    int64_t t = this->top.load(std::memory_order_acquire);
+    FutureDequeBuffer *buf = this->buffer.load(std::memory_order_relaxed);
+
+    if (b - t > buf->capacity - 1) {
+        buf = this->grow(t, b);
+    }
+
+    buf->slots[b & (buf->capacity - 1)].store(
+        toPush.release(), 
+        std::memory_order_relaxed
+    );
+
+    // Publish the slot (and the Future's contents) before the new bottom
+    std::atomic_thread_fence(std::memory_order_release);
+    this->bottom.store(b + 1, std::memory_order_relaxed);
+}
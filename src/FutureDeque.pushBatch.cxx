@@ -0,0 +1,44 @@
+/**
+ * FutureDeque.pushBatch.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * FutureDeque::pushBatch
+ * 
+ * Inserts all of a FutureBatch's Futures at the bottom of the deque, in
+ * order, publishing them with a single store. Owner only.
+ * 
+ * batch: Batch whose Futures to insert. Ownership of the Futures is 
+ *        passed to the deque.
+ */
+void FutureDeque::pushBatch(FutureBatch *batch) {
+
+    int64_t b = this->bottom.load(std::memory_order_relaxed);
+    int64_t t = this->top.load(std::memory_order_acquire);
+    FutureDequeBuffer *buf = this->buffer.load(std::memory_order_relaxed);
+
+    while (b - t + batch->nTasks > buf->capacity) {
+        buf = this->grow(t, b);
+    }
+
+    for (uint32_t iTask = 0; iTask < batch->nTasks; iTask++) {
+        buf->slots[(b + iTask) & (buf->capacity - 1)].store(
+            batch->futureAt(iTask), 
+            std::memory_order_relaxed
+        );
+    }
+
+    // Publish all slots (and the Futures' contents) before the new bottom
+    std::atomic_thread_fence(std::memory_order_release);
+    this->bottom.store(b + batch->nTasks, std::memory_order_relaxed);
+}
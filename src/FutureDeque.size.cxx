@@ -0,0 +1,30 @@
+
+/**
+ * FutureDeque.size.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * FutureDeque::size
+ * 
+ * How many Futures are in the deque? Reads two words without locking, so
+ * it's cheap enough for thieves to use as a load hint when picking a 
+ * victim - but only a snapshot when called by anyone other than the owner.
+ * 
+ * Return Value: Returns the number of Futures the deque looked like it 
+ *               held.
+ */
+int64_t FutureDeque::size() {
+    int64_t b = this->bottom.load(std::memory_order_relaxed);
+    int64_t t = this->top.load(std::memory_order_relaxed);
+    return b > t ? b - t : 0;
+}
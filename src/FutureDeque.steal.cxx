@@ -0,0 +1,50 @@
+
+/**
+ * FutureDeque.steal.cxx
+ */
+
+
+
+#include <memory>
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * FutureDeque::steal
+ * 
+ * Removes and returns the oldest Future (top). Any thread may call this.
+ * 
+ * Return Value: Returns a pointer to the stolen Future that owns its 
+ *               memory. Returns nullptr if the deque is empty or another
+ *               thread took the element first.
+ */
+UniquePtr<Future> FutureDeque::steal() {
+
+    int64_t t = this->top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t b = this->bottom.load(std::memory_order_acquire);
+
+    if (t >= b) {
+        return UniquePtr<Future>(nullptr);
+    }
+
+    FutureDequeBuffer *buf = this->buffer.load(std::memory_order_acquire);
+    Future *stolen = buf->slots[t & (buf->capacity - 1)].load(
+        std::memory_order_relaxed
+    );
+
+    // Lost the race to the owner or another thief
+    if (!this->top.compare_exchange_strong(t, 
+                                           t + 1, 
+                                           std::memory_order_seq_cst,
+                                           std::memory_order_relaxed)) {
+        return UniquePtr<Future>(nullptr);
+    }
+
+    return UniquePtr<Future>(stolen);
+}
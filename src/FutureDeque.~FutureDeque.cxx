@@ -0,0 +1,34 @@
+
+/**
+ * FutureDeque.~FutureDeque.cxx
+ * 
+ * Contains FutureDeque destructor definition.
+ */
+
+
+
+#include <memory>
+#include "_winpool_private.hxx"
+
+
+
+/**
+ * FutureDeque destructor
+ * 
+ * On destruction, all Futures still in the deque will be deleted.
+ */
+WinpoolNS::FutureDeque::~FutureDeque() {
+
+    // Deleting the current buffer deletes all the retired ones too
+    UniquePtr<FutureDequeBuffer> buf(
+        this->buffer.load(std::memory_order_relaxed)
+    );
+
+    int64_t t = this->top.load(std::memory_order_relaxed);
+    int64_t b = this->bottom.load(std::memory_order_relaxed);
+    for (int64_t i = t; i < b; i++) {
+        delete buf->slots[i & (buf->capacity - 1)].load(
+            std::memory_order_relaxed
+        );
+    }
+}
@@ -0,0 +1,27 @@
+
+/**
+ * FutureDequeBuffer.FutureDequeBuffer.cxx
+ */
+
+
+
+#include <memory>
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * FutureDequeBuffer constructor
+ * 
+ * capacity: Number of slots, must be a power of 2.
+ */
+FutureDequeBuffer::FutureDequeBuffer(int64_t capacity) :
+                   slots(new std::atomic<Future *>[capacity]),
+                   retired(nullptr) {
+
+    this->capacity = capacity;
+}
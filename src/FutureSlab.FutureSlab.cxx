@@ -0,0 +1,36 @@
+
+/**
+ * FutureSlab.FutureSlab.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+thread_local FutureSlab *FutureSlab::tlsMySlab = nullptr;
+
+
+
+/**
+ * FutureSlab constructor
+ * 
+ * Creates an empty slab. No memory is allocated until the first alloc.
+ */
+FutureSlab::FutureSlab() {
+    this->freeList = nullptr;
+    this->carveNext = nullptr;
+    this->nCarveLeft = 0;
+    this->chunks = nullptr;
+    this->remoteFree.store(nullptr, std::memory_order_relaxed);
+    this->remoteBalance.store(0, std::memory_order_relaxed);
+    this->nChunks.store(0, std::memory_order_relaxed);
+    this->nAllocs.store(0, std::memory_order_relaxed);
+    this->nLocalFrees.store(0, std::memory_order_relaxed);
+    this->nRemoteFrees.store(0, std::memory_order_relaxed);
+}
@@ -0,0 +1,72 @@
+
+/**
+ * FutureSlab.alloc.cxx
+ */
+
+
+
+#include <cstdlib>
+#include <new>
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * FutureSlab::alloc
+ * 
+ * Hands out a block big enough for a Future. Owner only.
+ * 
+ * Return Value: Returns a pointer to the Future memory (just past the 
+ *               block's header).
+ */
+void *FutureSlab::alloc() {
+
+    // Take over everything other threads freed once our own list runs dry
+    if (this->freeList == nullptr) {
+        this->freeList = this->remoteFree.exchange(
+            nullptr, 
+            std::memory_order_acquire
+        );
+    }
+
+    FutureSlabBlock *block = this->freeList;
+    if (block != nullptr) {
+        this->freeList = block->next;
+    }
+
+    // Nothing to recycle: carve a new block, getting a new chunk if needed
+    else {
+        if (this->nCarveLeft == 0) {
+            
+            // The first cache line holds the chunk list link
+            void *chunk = std::malloc(64 + futureBlockSize * slabChunkBlocks);
+            if (chunk == nullptr)
+                throw std::bad_alloc();
+            *(void **)chunk = this->chunks;
+            this->chunks = chunk;
+            this->carveNext = (char *)chunk + 64;
+            this->nCarveLeft = slabChunkBlocks;
+            this->nChunks.store(
+                this->nChunks.load(std::memory_order_relaxed) + 1,
+                std::memory_order_relaxed
+            );
+        }
+
+        block = (FutureSlabBlock *)this->carveNext;
+        block->home = this;
+        block->batch = nullptr;
+        this->carveNext += futureBlockSize;
+        this->nCarveLeft--;
+    }
+
+    this->nAllocs.store(
+        this->nAllocs.load(std::memory_order_relaxed) + 1,
+        std::memory_order_relaxed
+    );
+
+    return (void *)(block + 1);
+}
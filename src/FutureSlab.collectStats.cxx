@@ -0,0 +1,26 @@
+
+/**
+ * FutureSlab.collectStats.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * FutureSlab::collectStats
+ * 
+ * Adds this slab's counters to stats.
+ */
+void FutureSlab::collectStats(AllocatorStats *stats) {
+    stats->nChunks += this->nChunks.load(std::memory_order_relaxed);
+    stats->nAllocs += this->nAllocs.load(std::memory_order_relaxed);
+    stats->nLocalFrees += this->nLocalFrees.load(std::memory_order_relaxed);
+    stats->nRemoteFrees += this->nRemoteFrees.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,53 @@
+
+/**
+ * FutureSlab.free.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * FutureSlab::free
+ * 
+ * Returns a block to this slab. Any thread may call this.
+ * 
+ * block: Header of the block to free.
+ */
+void FutureSlab::free(FutureSlabBlock *block) {
+
+    // Freed by the owner: straight onto the private free list
+    if (tlsMySlab == this) {
+        block->next = this->freeList;
+        this->freeList = block;
+        this->nLocalFrees.store(
+            this->nLocalFrees.load(std::memory_order_relaxed) + 1,
+            std::memory_order_relaxed
+        );
+        return;
+    }
+
+    // Freed by another thread: push onto the remote stack. Only the owner 
+    // ever pops, and it takes the whole stack at once, so there's no ABA.
+    FutureSlabBlock *head = this->remoteFree.load(std::memory_order_relaxed);
+    do {
+        block->next = head;
+    } while (!this->remoteFree.compare_exchange_weak(
+                 head, 
+                 block, 
+                 std::memory_order_release,
+                 std::memory_order_relaxed));
+
+    this->nRemoteFrees.fetch_add(1, std::memory_order_relaxed);
+
+    // Last outstanding block of an orphaned slab
+    if (this->remoteBalance.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        delete this;
+    }
+}
@@ -0,0 +1,41 @@
+
+/**
+ * FutureSlab.orphan.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * FutureSlab::orphan
+ * 
+ * Called instead of delete when the owning worker goes away. The slab 
+ * deletes itself as soon as every block carved from it has been freed,
+ * which may be right away.
+ */
+void FutureSlab::orphan() {
+
+    // Every remote free so far already took 1 off remoteBalance, so adding 
+    // the blocks the owner didn't free leaves the number still in use
+    int64_t nOutstanding = 
+        (int64_t)this->nAllocs.load(std::memory_order_relaxed) 
+        - (int64_t)this->nLocalFrees.load(std::memory_order_relaxed);
+
+    if (tlsMySlab == this)
+        tlsMySlab = nullptr;
+
+    int64_t balance = this->remoteBalance.fetch_add(
+        nOutstanding, 
+        std::memory_order_acq_rel
+    ) + nOutstanding;
+    if (balance == 0) {
+        delete this;
+    }
+}
@@ -0,0 +1,25 @@
+
+/**
+ * FutureSlab.~FutureSlab.cxx
+ */
+
+
+
+#include <cstdlib>
+#include "_winpool_private.hxx"
+
+
+
+/**
+ * FutureSlab destructor
+ * 
+ * Frees all chunks. Only called once every block is free - use orphan.
+ */
+WinpoolNS::FutureSlab::~FutureSlab() {
+    void *chunk = this->chunks;
+    while (chunk != nullptr) {
+        void *next = *(void **)chunk;
+        std::free(chunk);
+        chunk = next;
+    }
+}
@@ -0,0 +1,42 @@
+/**
+ * InjectionQueue.InjectionQueue.cxx
+ * 
+ * Contains definitions for the InjectionQueue constructors and static 
+ * members.
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/* shardCount: Number of shards per lane of a queue. */
+static const int shardCount = 8;
+
+
+
+/* tlsProducerId: Calling thread's producer number, 0 until it first 
+                  pushes. */
+thread_local uint32_t InjectionQueue::tlsProducerId = 0;
+
+/* nextProducerId: Next producer number to hand out. */
+std::atomic<uint32_t> InjectionQueue::nextProducerId(1);
+
+
+
+/**
+ * InjectionQueue constructor
+ * 
+ * Creates an empty queue.
+ */
+InjectionQueue::InjectionQueue() {
+    this->nShards = shardCount;
+    this->shards = UniquePtr<InjectionShard[]>(
+        new InjectionShard[nPriorities * shardCount]
+    );
+}
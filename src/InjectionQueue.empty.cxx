@@ -0,0 +1,31 @@
+/**
+ * InjectionQueue.empty.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * InjectionQueue::empty
+ * 
+ * Return Value: Returns true if no lane of any shard has a Future. Only
+ *               a hint while other threads push or pop.
+ */
+bool InjectionQueue::empty() {
+
+    // head only points at the stub when there is nothing behind it
+    for (int iShard = 0; iShard < nPriorities * this->nShards; iShard++) {
+        InjectionShard *shard = &this->shards[iShard];
+        if (shard->head.load(std::memory_order_acquire) != &shard->stub) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,81 @@
+/**
+ * InjectionQueue.pop.cxx
+ */
+
+
+
+#include <memory>
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * popLane
+ * 
+ * Removes a Future from the first shard of lane, starting at start, that 
+ * has one and isn't busy.
+ */
+static Future *popLane(InjectionShard *lane, int nShards, uint64_t start) {
+
+    for (int i = 0; i < nShards; i++) {
+        Future *popped = lane[(start + i) % (uint64_t)nShards].tryPop();
+        if (popped != nullptr) {
+            return popped;
+        }
+    }
+
+    return nullptr;
+}
+
+
+
+/**
+ * InjectionQueue::pop
+ * 
+ * Removes a Future from the highest lane that has one (or a lower lane 
+ * being aged), from the first shard, starting at start, that has one 
+ * and isn't busy. Any thread may call this.
+ * 
+ * start: Where to start scanning (taken modulo nShards). Pass something
+ *        random so consumers spread out: its high bits also pick the 
+ *        pops that age lower lanes.
+ * 
+ * Return Value: Returns a pointer to the popped Future that owns its 
+ *               memory. Returns nullptr if nothing could be popped.
+ */
+UniquePtr<Future> InjectionQueue::pop(uint64_t start) {
+
+    // Aging: lane i goes first on about one pop in agingPeriod^i, so a 
+    // flood of higher priority work slows lower lanes down but never 
+    // stops them
+    uint64_t agingBits = start >> 32;
+    uint64_t period = agingPeriod;
+    int firstLane = 0;
+    for (int iLane = 1; iLane < nPriorities; iLane++) {
+        if (agingBits % period == 0) {
+            firstLane = iLane;
+        }
+        period *= agingPeriod;
+    }
+
+    Future *popped = popLane(
+        &this->shards[firstLane * this->nShards], 
+        this->nShards, 
+        start
+    );
+    for (int iLane = 0; iLane < nPriorities && popped == nullptr; iLane++) {
+        if (iLane != firstLane) {
+            popped = popLane(
+                &this->shards[iLane * this->nShards], 
+                this->nShards, 
+                start
+            );
+        }
+    }
+
+    return UniquePtr<Future>(popped);
+}
@@ -0,0 +1,28 @@
+/**
+ * InjectionQueue.push.cxx
+ */
+
+
+
+#include <memory>
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * InjectionQueue::push
+ * 
+ * Inserts a Future into the calling thread's shard of the Future's 
+ * priority lane. Any thread may call this.
+ * 
+ * toPush: Pointer to the Future to insert with ownership passed to this
+ *         function.
+ */
+void InjectionQueue::push(UniquePtr<Future> toPush) {
+    Future *bToPush = toPush.release();
+    this->pushChain(bToPush, bToPush);
+}
@@ -0,0 +1,36 @@
+/**
+ * InjectionQueue.pushChain.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * InjectionQueue::pushChain
+ * 
+ * Inserts a chain of Futures, already linked from first to last through
+ * queueNext, into the calling thread's shard with a single exchange. 
+ * The chain goes into first's priority lane. Any thread may call this.
+ * 
+ * first: Oldest Future of the chain.
+ * last: Newest Future of the chain. Ownership of the whole chain is 
+ *       passed to the queue.
+ */
+void InjectionQueue::pushChain(Future *first, Future *last) {
+
+    uint32_t producerId = tlsProducerId;
+    if (producerId == 0) {
+        producerId = nextProducerId.fetch_add(1, std::memory_order_relaxed);
+        tlsProducerId = producerId;
+    }
+
+    InjectionShard *lane = &this->shards[first->priority * this->nShards];
+    lane[producerId % this->nShards].pushChain(first, last);
+}
@@ -0,0 +1,28 @@
+/**
+ * InjectionShard.InjectionShard.cxx
+ * 
+ * Contains definitions for the InjectionShard constructors.
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * InjectionShard constructor
+ * 
+ * Creates an empty shard.
+ */
+InjectionShard::InjectionShard() :
+        stub(true) {
+
+    this->head.store(&this->stub, std::memory_order_relaxed);
+    this->consumerBusy.store(false, std::memory_order_relaxed);
+    this->tail = &this->stub;
+}
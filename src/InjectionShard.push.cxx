@@ -0,0 +1,24 @@
+/**
+ * InjectionShard.push.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * InjectionShard::push
+ * 
+ * Inserts a Future at the head. Any thread may call this.
+ * 
+ * toPush: Future to insert, with ownership passed to the shard.
+ */
+void InjectionShard::push(Future *toPush) {
+    this->pushChain(toPush, toPush);
+}
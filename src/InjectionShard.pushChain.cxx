@@ -0,0 +1,32 @@
+/**
+ * InjectionShard.pushChain.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * InjectionShard::pushChain
+ * 
+ * Inserts a chain of Futures, already linked from first to last through
+ * queueNext, with a single exchange. Any thread may call this.
+ * 
+ * first: Oldest Future of the chain.
+ * last: Newest Future of the chain. Ownership of the whole chain is 
+ *       passed to the shard.
+ */
+void InjectionShard::pushChain(Future *first, Future *last) {
+
+    last->queueNext.store(nullptr, std::memory_order_relaxed);
+
+    // Until the link below is stored, the consumer can't get past prev
+    Future *prev = this->head.exchange(last, std::memory_order_acq_rel);
+    prev->queueNext.store(first, std::memory_order_release);
+}
@@ -0,0 +1,73 @@
+/**
+ * InjectionShard.tryPop.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * InjectionShard::tryPop
+ * 
+ * Removes the oldest Future if no other consumer is popping from this 
+ * shard right now. Any thread may call this.
+ * 
+ * Return Value: Returns the popped Future with ownership passed to the 
+ *               caller. Returns nullptr if the shard is empty, busy, or
+ *               a producer is half-way through pushing the only 
+ *               element.
+ */
+Future *InjectionShard::tryPop() {
+
+    // head only points at the stub when there is nothing behind it, so idle
+    // workers can skip empty shards with one plain load
+    if (this->head.load(std::memory_order_acquire) == &this->stub) {
+        return nullptr;
+    }
+
+    if (this->consumerBusy.load(std::memory_order_relaxed) || 
+            this->consumerBusy.exchange(true, std::memory_order_acquire)) {
+        return nullptr;
+    }
+
+    Future *popped = nullptr;
+    Future *tail = this->tail;
+    Future *next = tail->queueNext.load(std::memory_order_acquire);
+
+    // Skip over the stub
+    if (tail == &this->stub && next != nullptr) {
+        this->tail = next;
+        tail = next;
+        next = next->queueNext.load(std::memory_order_acquire);
+    }
+
+    if (tail != &this->stub) {
+
+        if (next != nullptr) {
+            this->tail = next;
+            popped = tail;
+        }
+
+        // tail is the last element: queue the stub behind it so tail can be
+        // unlinked. If tail isn't head, a producer has swapped itself in but
+        // not linked itself yet - come back later.
+        else if (tail == this->head.load(std::memory_order_acquire)) {
+            this->push(&this->stub);
+            next = tail->queueNext.load(std::memory_order_acquire);
+            if (next != nullptr) {
+                this->tail = next;
+                popped = tail;
+            }
+        }
+    }
+
+    this->consumerBusy.store(false, std::memory_order_release);
+
+    return popped;
+}
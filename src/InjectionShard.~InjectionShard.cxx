@@ -0,0 +1,24 @@
+/**
+ * InjectionShard.~InjectionShard.cxx
+ * 
+ * Contains InjectionShard destructor definition.
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+/**
+ * InjectionShard destructor
+ * 
+ * On destruction, all Futures still in the shard will be deleted.
+ */
+WinpoolNS::InjectionShard::~InjectionShard() {
+
+    Future *fut;
+    while ((fut = this->tryPop()) != nullptr) {
+        delete fut;
+    }
+}
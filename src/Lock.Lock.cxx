@@ -0,0 +1,32 @@
+
+/**
+ * Lock.Lock.cxx
+ */
+
+
+
+#include <iso646.h>
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * Lock constructor
+ *
+ * Initializes an unlocked lock.
+ * Throws a SyscallError if the lock can't be initialized.
+ */
+Lock::Lock() {
+#ifdef _WIN32
+    BOOL boolRc = InitializeCriticalSectionAndSpinCount(&this->cs, spinCount);
+    if (not boolRc) {
+        throw SyscallError(lastErrorCode());
+    }
+#else
+    this->word.store(0, std::memory_order_relaxed);
+#endif
+}
@@ -0,0 +1,43 @@
+
+/**
+ * Lock.enter.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * Lock::enter
+ *
+ * Acquires the lock, blocking until it's available.
+ */
+void Lock::enter() {
+#ifdef _WIN32
+    EnterCriticalSection(&this->cs);
+#else
+    uint32_t c;
+
+    // Spin for a while in case the holder is about to leave
+    for (uint32_t iSpin = 0; iSpin < spinCount; iSpin++) {
+        c = 0;
+        if (this->word.compare_exchange_weak(c, 1, std::memory_order_acquire))
+            return;
+    }
+
+    // Mark the lock contended and sleep until we get it. We can't tell if
+    // anyone else is still asleep when we wake up, so we always take the lock
+    // in the contended state and let leave() issue the wake.
+    c = this->word.exchange(2, std::memory_order_acquire);
+    while (c != 0) {
+        waitOnAddress(&this->word, 2);
+        c = this->word.exchange(2, std::memory_order_acquire);
+    }
+#endif
+}
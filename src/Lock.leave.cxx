@@ -0,0 +1,28 @@
+
+/**
+ * Lock.leave.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * Lock::leave
+ *
+ * Releases the lock. Must be called by the thread holding it.
+ */
+void Lock::leave() {
+#ifdef _WIN32
+    LeaveCriticalSection(&this->cs);
+#else
+    if (this->word.exchange(0, std::memory_order_release) == 2)
+        wakeAddressOne(&this->word);
+#endif
+}
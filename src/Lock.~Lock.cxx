@@ -0,0 +1,19 @@
+
+/**
+ * Lock.~Lock.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+/**
+ * Lock destructor
+ */
+WinpoolNS::Lock::~Lock() {
+#ifdef _WIN32
+    DeleteCriticalSection(&this->cs);
+#endif
+}
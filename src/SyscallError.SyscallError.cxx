@@ -16,8 +16,8 @@ using namespace WinpoolNS;
 /**
  * SyscallError constructor
  * 
- * error: Error code returned by GetLastError
+ * error: Error code returned by lastErrorCode
  */
-SyscallError::SyscallError(DWORD error) {
+SyscallError::SyscallError(ErrorCode error) {
     this->error = error;
 }
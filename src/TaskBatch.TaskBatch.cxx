@@ -0,0 +1,30 @@
+/**
+ * TaskBatch.TaskBatch.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * TaskBatch constructor
+ * 
+ * batch: Batch to hold, with the caller's reference passed to the 
+ *        handle.
+ */
+TaskBatch::TaskBatch(FutureBatch *batch) : batch(batch) { }
+
+
+
+/**
+ * TaskBatch move constructor
+ */
+TaskBatch::TaskBatch(TaskBatch &&other) : batch(other.batch) {
+    other.batch = nullptr;
+}
@@ -0,0 +1,22 @@
+/**
+ * TaskBatch.done.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * TaskBatch::done
+ * 
+ * Return Value: Returns true if every task in the batch has finished.
+ */
+bool TaskBatch::done() {
+    return this->batch->nPending.load(std::memory_order_acquire) == 0;
+}
@@ -0,0 +1,23 @@
+/**
+ * TaskBatch.join.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * TaskBatch::join
+ * 
+ * Waits until every task in the batch has finished. Worker threads run
+ * other tasks meanwhile, external threads sleep.
+ */
+void TaskBatch::join() {
+    this->batch->join();
+}
@@ -0,0 +1,24 @@
+/**
+ * TaskBatch.~TaskBatch.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * TaskBatch destructor
+ * 
+ * Drops the handle's reference without waiting for the tasks.
+ */
+TaskBatch::~TaskBatch() {
+    if (this->batch != nullptr) {
+        this->batch->release();
+    }
+}
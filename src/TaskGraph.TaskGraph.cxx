@@ -0,0 +1,25 @@
+
+/**
+ * TaskGraph.TaskGraph.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * TaskGraph constructor
+ * 
+ * bPool: Pool to run the graph on.
+ */
+TaskGraph::TaskGraph(Winpool *bPool) {
+    this->bPool = bPool;
+    this->batch = nullptr;
+    this->built = false;
+}
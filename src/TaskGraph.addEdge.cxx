@@ -0,0 +1,31 @@
+
+/**
+ * TaskGraph.addEdge.cxx
+ */
+
+
+
+#include <assert.h>
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * TaskGraph::addEdge
+ * 
+ * Makes node iTo wait for node iFrom in every run. Don't call this during
+ * a run. The graph must stay acyclic.
+ * 
+ * iFrom: Index of the node that runs first.
+ * iTo: Index of the node that depends on it.
+ */
+void TaskGraph::addEdge(uint32_t iFrom, uint32_t iTo) {
+    assert(iFrom < this->tasks.size() && iTo < this->tasks.size());
+    this->successors[iFrom].push_back(iTo);
+    this->inDegrees[iTo]++;
+    this->built = false;
+}
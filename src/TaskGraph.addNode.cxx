@@ -0,0 +1,32 @@
+
+/**
+ * TaskGraph.addNode.cxx
+ */
+
+
+
+#include <utility>
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * TaskGraph::addNode
+ * 
+ * Adds a node running task. Don't call this during a run.
+ * 
+ * task: Callable to run once per launch.
+ * 
+ * Return Value: Returns the node's index, to pass to addEdge.
+ */
+uint32_t TaskGraph::addNode(GraphTask task) {
+    this->tasks.push_back(std::move(task));
+    this->successors.emplace_back();
+    this->inDegrees.push_back(0);
+    this->built = false;
+    return (uint32_t)(this->tasks.size() - 1);
+}
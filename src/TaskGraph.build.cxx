@@ -0,0 +1,68 @@
+
+/**
+ * TaskGraph.build.cxx
+ */
+
+
+
+#include <vector>
+#include <assert.h>
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * TaskGraph::build
+ * 
+ * Works out the roots and sets up the node Futures' batch after nodes or 
+ * edges changed. launch calls this when needed.
+ */
+void TaskGraph::build() {
+
+    uint32_t nNodes = (uint32_t)this->tasks.size();
+
+    this->roots.clear();
+    for (uint32_t iNode = 0; iNode < nNodes; iNode++) {
+        if (this->inDegrees[iNode] == 0) {
+            this->roots.push_back(iNode);
+        }
+    }
+
+#ifndef NDEBUG
+    // A cycle would leave its nodes waiting forever: check that peeling off
+    // nodes with no dependencies left gets through all of them
+    {
+        std::vector<uint32_t> nDepsLeft(this->inDegrees);
+        std::vector<uint32_t> ready(this->roots);
+        uint32_t nVisited = 0;
+        while (!ready.empty()) {
+            uint32_t iNode = ready.back();
+            ready.pop_back();
+            nVisited++;
+            for (uint32_t iSucc : this->successors[iNode]) {
+                if (--nDepsLeft[iSucc] == 0) {
+                    ready.push_back(iSucc);
+                }
+            }
+        }
+        assert(nVisited == nNodes);
+    }
+#endif
+
+    this->nPendingDeps.reset(new std::atomic<uint32_t>[nNodes]);
+
+    // Any run still using the old batch is over (see launch), but its 
+    // Futures may not be gone yet: they keep it alive
+    if (this->batch != nullptr) {
+        this->batch->release();
+    }
+    this->batch = FutureBatch::create(this->bPool, nNodes, 0);
+    this->batch->nRefs.store(1, std::memory_order_relaxed);
+    this->batch->nPending.store(0, std::memory_order_relaxed);
+
+    this->built = true;
+}
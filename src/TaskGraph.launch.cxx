@@ -0,0 +1,62 @@
+
+/**
+ * TaskGraph.launch.cxx
+ */
+
+
+
+#include <memory>
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * TaskGraph::launch
+ * 
+ * Starts a run of the whole graph and returns without waiting for it 
+ * (after waiting for the previous run).
+ */
+void TaskGraph::launch() {
+
+    this->wait();
+    if (!this->built) {
+        this->build();
+    }
+
+    FutureBatch *bBatch = this->batch;
+    uint32_t nNodes = bBatch->nTasks;
+    if (nNodes == 0)
+        return;
+
+    // The last run's tasks are done, but their executors may still be 
+    // destroying the Futures we're about to rebuild in place
+    while (bBatch->nRefs.load(std::memory_order_acquire) != 1) {
+        yieldThread();
+    }
+
+    bBatch->nRefs.store((int64_t)nNodes + 1, std::memory_order_relaxed);
+    bBatch->nPending.store(nNodes, std::memory_order_relaxed);
+
+    // Rebuild every node's Future in its block: the task only captures the
+    // graph and the index, so it fits inline
+    TaskGraph *bGraph = this;
+    for (uint32_t iNode = 0; iNode < nNodes; iNode++) {
+        this->nPendingDeps[iNode].store(
+            this->inDegrees[iNode], 
+            std::memory_order_relaxed
+        );
+        Future *fut = bBatch->newFuture(iNode);
+        fut->setTask([bGraph, iNode]() {
+            bGraph->runNode(iNode);
+        });
+    }
+
+    // Submitting publishes the stores above to whoever runs the roots
+    for (uint32_t iRoot : this->roots) {
+        this->bPool->submitFuture(UniquePtr<Future>(bBatch->futureAt(iRoot)));
+    }
+}
@@ -0,0 +1,71 @@
+
+/**
+ * TaskGraph.runNode.cxx
+ */
+
+
+
+#include <memory>
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * TaskGraph::runNode
+ * 
+ * Task of node iNode's Future: runs the node, then every dependent it was
+ * the last dependency of - one right here, the rest submitted.
+ * 
+ * iNode: Index of the node.
+ */
+void TaskGraph::runNode(uint32_t iNode) {
+
+    FutureBatch *bBatch = this->batch;
+    uint32_t iCur = iNode;
+    bool haveNext;
+
+    do {
+        try {
+            this->tasks[iCur]();
+        }
+        catch (TaskCancelled &) {
+            // Dependents still run: they only wait for the node to finish
+        }
+
+        // Keep the first dependent we release for ourselves - no point 
+        // queueing it just to pop it right back - and submit the rest
+        uint32_t iNext = 0;
+        haveNext = false;
+        for (uint32_t iSucc : this->successors[iCur]) {
+            if (this->nPendingDeps[iSucc].fetch_sub(
+                    1, 
+                    std::memory_order_acq_rel) != 1) {
+                continue;
+            }
+            if (!haveNext) {
+                iNext = iSucc;
+                haveNext = true;
+            }
+            else {
+                this->bPool->submitFuture(
+                    UniquePtr<Future>(bBatch->futureAt(iSucc))
+                );
+            }
+        }
+
+        // Its Future won't go through a queue: drop it here instead
+        if (haveNext) {
+            delete bBatch->futureAt(iNext);
+        }
+
+        // Last: once the run is over, the graph may be rebuilt or destroyed.
+        // It can't be while we still have a node to run.
+        bBatch->finishTask();
+        iCur = iNext;
+
+    } while (haveNext);
+}
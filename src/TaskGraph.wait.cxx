@@ -0,0 +1,26 @@
+
+/**
+ * TaskGraph.wait.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * TaskGraph::wait
+ * 
+ * Waits until the current run has finished. Worker threads run other 
+ * tasks meanwhile, external threads sleep.
+ */
+void TaskGraph::wait() {
+    if (this->batch != nullptr) {
+        this->batch->join();
+    }
+}
@@ -0,0 +1,29 @@
+
+/**
+ * TaskGraph.~TaskGraph.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * TaskGraph destructor
+ * 
+ * Waits for the current run, if any.
+ */
+TaskGraph::~TaskGraph() {
+    this->wait();
+
+    // The last run's Futures may still hold references: the batch frees 
+    // itself once they're gone
+    if (this->batch != nullptr) {
+        this->batch->release();
+    }
+}
@@ -0,0 +1,24 @@
+
+/**
+ * TaskGroup.TaskGroup.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * TaskGroup constructor
+ * 
+ * bPool: Pool to spawn children into.
+ */
+TaskGroup::TaskGroup(Winpool *bPool) {
+    this->bPool = bPool;
+    this->state.store(0, std::memory_order_relaxed);
+}
@@ -0,0 +1,23 @@
+
+/**
+ * TaskGroup.done.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * TaskGroup::done
+ * 
+ * Return Value: Returns true if every child run so far has finished.
+ */
+bool TaskGroup::done() {
+    return (this->state.load(std::memory_order_acquire) & ~waiterBit) == 0;
+}
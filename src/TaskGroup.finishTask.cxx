@@ -0,0 +1,32 @@
+
+/**
+ * TaskGroup.finishTask.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * TaskGroup::finishTask
+ * 
+ * Called by each child once it has run. Wakes up external waiters after 
+ * the last one.
+ */
+void TaskGroup::finishTask() {
+
+    // Once the count hits 0 the waiter may return and destroy the group, so
+    // the old value has to tell us everything: only the address is used 
+    // after this, and waking an address nobody sleeps on does nothing
+    std::atomic<uint32_t> *bState = &this->state;
+    uint32_t prevState = bState->fetch_sub(1, std::memory_order_acq_rel);
+    if (prevState == (waiterBit | 1)) {
+        wakeAddressAll(bState);
+    }
+}
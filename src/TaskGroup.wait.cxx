@@ -0,0 +1,58 @@
+
+/**
+ * TaskGroup.wait.cxx
+ */
+
+
+
+#include <memory>
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * TaskGroup::wait
+ * 
+ * Waits until every child run so far has finished. Worker threads run 
+ * other tasks meanwhile - the children first, since they're on top of 
+ * their own deque. External threads sleep.
+ */
+void TaskGroup::wait() {
+
+    if (this->done())
+        return;
+
+    Winpool *bPool = this->bPool;
+    Worker *myWorker = (Worker *)bPool->workerTls.get();
+
+    // Worker: one counter to check no matter how many children there are, 
+    // and whatever we find in the meantime is most likely one of them
+    if (myWorker != nullptr) {
+        while (!this->done()) {
+            UniquePtr<Future> fut = findTask(bPool, myWorker);
+            if (fut != nullptr)
+                executeFuture(std::move(fut), myWorker);
+            else
+                yieldThread();
+        }
+        return;
+    }
+
+    // External thread: announce ourselves in the same word the children 
+    // count down, so the last one knows to wake us
+    uint32_t curState = this->state.fetch_or(
+        waiterBit, 
+        std::memory_order_acquire
+    ) | waiterBit;
+    while (curState != waiterBit) {
+        waitOnAddress(&this->state, curState);
+        curState = this->state.load(std::memory_order_acquire);
+    }
+
+    // Everything has finished, so nobody else touches the word right now
+    this->state.store(0, std::memory_order_relaxed);
+}
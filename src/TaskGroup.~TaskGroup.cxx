@@ -0,0 +1,23 @@
+
+/**
+ * TaskGroup.~TaskGroup.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * TaskGroup destructor
+ * 
+ * Waits for every child that is still running.
+ */
+TaskGroup::~TaskGroup() {
+    this->wait();
+}
@@ -0,0 +1,28 @@
+
+/**
+ * Thread.Thread.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * Thread constructor
+ *
+ * Creates a handle with no thread behind it - call start.
+ */
+Thread::Thread() {
+#ifdef _WIN32
+    this->handle = nullptr;
+#endif
+    this->started = false;
+    this->proc = nullptr;
+    this->arg = nullptr;
+}
@@ -0,0 +1,35 @@
+
+/**
+ * Thread.join.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * Thread::join
+ *
+ * Blocks until the thread exits and releases its OS resources.
+ */
+void Thread::join() {
+
+    if (!this->started)
+        return;
+
+#ifdef _WIN32
+    WaitForSingleObject(this->handle, INFINITE);
+    CloseHandle(this->handle);
+    this->handle = nullptr;
+#else
+    pthread_join(this->handle, nullptr);
+#endif
+
+    this->started = false;
+}
@@ -0,0 +1,42 @@
+/**
+ * Thread.pinToCpu.cxx
+ */
+
+
+
+#ifndef _WIN32
+#include <sched.h>
+#endif
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * Thread::pinToCpu
+ *
+ * Restricts the started thread to run on one logical CPU.
+ *
+ * cpu: CpuPlace::cpu of the CPU.
+ *
+ * Return Value: Returns false if the OS refused, in which case the thread
+ *               may keep running anywhere.
+ */
+bool Thread::pinToCpu(uint32_t cpu) {
+#ifdef _WIN32
+    GROUP_AFFINITY affinity = {};
+    affinity.Group = (WORD)(cpu / 64);
+    affinity.Mask = (KAFFINITY)1 << (cpu % 64);
+    return SetThreadGroupAffinity(this->handle, &affinity, NULL) != 0;
+#else
+    if (cpu >= CPU_SETSIZE)
+        return false;
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(cpu, &cpus);
+    return pthread_setaffinity_np(this->handle, sizeof(cpus), &cpus) == 0;
+#endif
+}
@@ -0,0 +1,74 @@
+
+/**
+ * Thread.start.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * threadTrampoline
+ *
+ * Entry point handed to the OS: adapts the OS thread function signature to
+ * Thread::Proc.
+ *
+ * arg: Borrowed pointer to the Thread being started.
+ */
+#ifdef _WIN32
+static DWORD WINAPI threadTrampoline(void *arg) {
+    Thread *thread = (Thread *)arg;
+    thread->proc(thread->arg);
+    return 0;
+}
+#else
+static void *threadTrampoline(void *arg) {
+    Thread *thread = (Thread *)arg;
+    thread->proc(thread->arg);
+    return nullptr;
+}
+#endif
+
+
+
+/**
+ * Thread::start
+ *
+ * Starts a new OS thread running proc(arg).
+ * Throws a SyscallError if the thread can't be created.
+ *
+ * proc: Function the new thread runs.
+ * arg: Argument passed to proc.
+ */
+void Thread::start(Proc proc, void *arg) {
+
+    this->proc = proc;
+    this->arg = arg;
+
+#ifdef _WIN32
+    this->handle = CreateThread(
+        NULL,
+        0,
+        threadTrampoline,
+        (LPVOID)this,
+        0,
+        NULL
+    );
+    if (this->handle == NULL) {
+        throw SyscallError(lastErrorCode());
+    }
+#else
+    int rc = pthread_create(&this->handle, nullptr, threadTrampoline, this);
+    if (rc != 0) {
+        throw SyscallError(rc);
+    }
+#endif
+
+    this->started = true;
+}
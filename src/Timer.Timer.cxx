@@ -0,0 +1,35 @@
+/**
+ * Timer.Timer.cxx
+ */
+
+
+
+#include <utility>
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * Timer constructor
+ * 
+ * Creates a timer that isn't armed yet, with one reference for the 
+ * TimerHandle and one for the wheel.
+ * 
+ * bPool: Pool to run task on.
+ * task: Callable to run when the timer fires.
+ * periodTicks: Ticks between firings, 0 for a one-shot timer.
+ */
+Timer::Timer(Winpool *bPool, TimerTask task, uint64_t periodTicks) : 
+        nRefs(2),
+        bPool(bPool),
+        task(std::move(task)),
+        deadlineTick(0),
+        periodTicks(periodTicks),
+        iSlot(-1),
+        prev(nullptr),
+        next(nullptr),
+        fireNext(nullptr) { }
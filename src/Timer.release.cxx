@@ -0,0 +1,24 @@
+/**
+ * Timer.release.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * Timer::release
+ * 
+ * Drops one reference, deleting the timer if it was the last one.
+ */
+void Timer::release() {
+    if (this->nRefs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        delete this;
+    }
+}
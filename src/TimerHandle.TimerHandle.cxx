@@ -0,0 +1,30 @@
+/**
+ * TimerHandle.TimerHandle.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * TimerHandle constructor
+ * 
+ * timer: Timer to hold, with the caller's reference passed to the 
+ *        handle.
+ */
+TimerHandle::TimerHandle(Timer *timer) : timer(timer) { }
+
+
+
+/**
+ * TimerHandle move constructor
+ */
+TimerHandle::TimerHandle(TimerHandle &&other) : timer(other.timer) {
+    other.timer = nullptr;
+}
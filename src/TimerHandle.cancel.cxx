@@ -0,0 +1,45 @@
+/**
+ * TimerHandle.cancel.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * TimerHandle::cancel
+ * 
+ * Disarms the timer in O(1). A firing whose task already started isn't
+ * stopped.
+ * 
+ * Return Value: Returns true if the timer was armed, i.e. this stopped
+ *               it from firing (again).
+ */
+bool TimerHandle::cancel() {
+
+    if (this->timer == nullptr)
+        return false;
+
+    TimerWheel *wheel = &this->timer->bPool->timers;
+
+    wheel->lock.enter();
+    bool wasArmed = this->timer->iSlot >= 0;
+    if (wasArmed) {
+        wheel->remove(this->timer);
+        wheel->updateDue();
+    }
+    wheel->lock.leave();
+
+    // We took over the wheel's reference
+    if (wasArmed) {
+        this->timer->release();
+    }
+
+    return wasArmed;
+}
@@ -0,0 +1,24 @@
+/**
+ * TimerHandle.~TimerHandle.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * TimerHandle destructor
+ * 
+ * Drops the handle's reference. The timer stays armed.
+ */
+TimerHandle::~TimerHandle() {
+    if (this->timer != nullptr) {
+        this->timer->release();
+    }
+}
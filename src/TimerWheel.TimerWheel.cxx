@@ -0,0 +1,35 @@
+/**
+ * TimerWheel.TimerWheel.cxx
+ */
+
+
+
+#include <cstdint>
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * TimerWheel constructor
+ * 
+ * Creates an empty wheel starting at the current tick.
+ */
+TimerWheel::TimerWheel() : 
+        lock(),
+        busy(false),
+        dueNs(UINT64_MAX),
+        keeperWakeNs(UINT64_MAX) {
+
+    this->curTick = monotonicNs() / timerTickNs;
+    this->nTimers = 0;
+    for (int iLevel = 0; iLevel < timerWheelLevels; iLevel++) {
+        this->occupied[iLevel] = 0;
+        for (int iSlot = 0; iSlot < timerWheelSlots; iSlot++) {
+            this->slots[iLevel][iSlot] = nullptr;
+        }
+    }
+}
@@ -0,0 +1,113 @@
+/**
+ * TimerWheel.advance.cxx
+ */
+
+
+
+#include <cstdint>
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * TimerWheel::advance
+ * 
+ * Processes every tick up to and including nowTick: cascades slots, 
+ * disarms one-shot timers that fire and re-arms periodic ones, then 
+ * updates dueNs. Call it with lock held.
+ * 
+ * nowTick: Current tick.
+ * 
+ * Return Value: Returns the timers that fired, chained through 
+ *               fireNext, each with a reference for its firing.
+ */
+Timer *TimerWheel::advance(uint64_t nowTick) {
+
+    Timer *fired = nullptr;
+
+    while (this->curTick <= nowTick) {
+
+        // Ticks with nothing to do are skipped over
+        uint64_t tick = this->nextDueTick();
+        if (tick > nowTick) {
+            this->curTick = nowTick + 1;
+            break;
+        }
+        this->curTick = tick;
+
+        // Cascade the slot of every level whose block starts at this tick,
+        // top down, since a cascade may fill the slot below
+        int iTopLevel = 0;
+        while (iTopLevel + 1 < timerWheelLevels) {
+            uint64_t blockMask = 
+                ((uint64_t)1 << (timerWheelBits * (iTopLevel + 1))) - 1;
+            if ((tick & blockMask) != 0)
+                break;
+            iTopLevel++;
+        }
+        for (int iLevel = iTopLevel; iLevel > 0; iLevel--) {
+            int iSlot = (int)(tick >> (timerWheelBits * iLevel)) & 
+                        (timerWheelSlots - 1);
+            Timer *timer = this->slots[iLevel][iSlot];
+            while (timer != nullptr) {
+                Timer *next = timer->next;
+                this->remove(timer);
+                this->insert(timer);
+                timer = next;
+            }
+        }
+
+        // Fire level 0's slot. Timers to arm again wait until curTick has 
+        // moved past this tick, so they can't land back in this slot.
+        int iSlot = (int)tick & (timerWheelSlots - 1);
+        Timer *timer = this->slots[0][iSlot];
+        Timer *rearm = nullptr;
+        while (timer != nullptr) {
+            Timer *next = timer->next;
+            this->remove(timer);
+
+            // Parked at the end of the top level's block: go round again
+            if (timer->deadlineTick > tick) {
+                timer->next = rearm;
+                rearm = timer;
+                timer = next;
+                continue;
+            }
+
+            timer->fireNext = fired;
+            fired = timer;
+
+            // A periodic timer keeps its wheel reference and takes another 
+            // one for the firing; a one-shot timer's passes to the firing
+            if (timer->periodTicks != 0) {
+                timer->nRefs.fetch_add(1, std::memory_order_relaxed);
+                // Runs that are already late are skipped, keeping the phase
+                uint64_t period = timer->periodTicks;
+                timer->deadlineTick += period;
+                if (timer->deadlineTick <= nowTick) {
+                    timer->deadlineTick += 
+                        ((nowTick - timer->deadlineTick) / period + 1) * period;
+                }
+                timer->next = rearm;
+                rearm = timer;
+            }
+
+            timer = next;
+        }
+
+        this->curTick = tick + 1;
+        while (rearm != nullptr) {
+            timer = rearm;
+            rearm = timer->next;
+            this->insert(timer);
+        }
+    }
+
+    this->updateDue();
+
+    return fired;
+}
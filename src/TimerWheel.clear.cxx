@@ -0,0 +1,33 @@
+/**
+ * TimerWheel.clear.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * TimerWheel::clear
+ * 
+ * Disarms every timer in the wheel, without firing them. Call it with 
+ * lock held.
+ */
+void TimerWheel::clear() {
+
+    for (int iLevel = 0; iLevel < timerWheelLevels; iLevel++) {
+        for (int iSlot = 0; iSlot < timerWheelSlots; iSlot++) {
+            while (this->slots[iLevel][iSlot] != nullptr) {
+                Timer *timer = this->slots[iLevel][iSlot];
+                this->remove(timer);
+                timer->release();
+            }
+        }
+    }
+    this->updateDue();
+}
@@ -0,0 +1,59 @@
+/**
+ * TimerWheel.insert.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * TimerWheel::insert
+ * 
+ * Arms a timer for its deadlineTick (or curTick, if that has passed). 
+ * Call it with lock held.
+ * 
+ * timer: Timer to arm, with its wheel reference passed to the wheel.
+ */
+void TimerWheel::insert(Timer *timer) {
+
+    uint64_t tick = timer->deadlineTick;
+    if (tick < this->curTick) {
+        tick = this->curTick;
+    }
+
+    // Past the end of the top level's block: wait in its last slot, and go
+    // round again from there (advance re-inserts timers that aren't due)
+    const int topShift = timerWheelBits * timerWheelLevels;
+    uint64_t lastTick = (this->curTick | (((uint64_t)1 << topShift) - 1));
+    if (tick > lastTick) {
+        tick = lastTick;
+    }
+
+    // The level is the lowest one whose current block tick falls in
+    int iLevel = 0;
+    while (iLevel + 1 < timerWheelLevels && 
+           (tick >> (timerWheelBits * (iLevel + 1))) != 
+               (this->curTick >> (timerWheelBits * (iLevel + 1)))) {
+        iLevel++;
+    }
+    int iSlot = (int)(tick >> (timerWheelBits * iLevel)) & 
+                (timerWheelSlots - 1);
+
+    Timer **head = &this->slots[iLevel][iSlot];
+    timer->prev = nullptr;
+    timer->next = *head;
+    if (*head != nullptr) {
+        (*head)->prev = timer;
+    }
+    *head = timer;
+
+    timer->iSlot = iLevel * timerWheelSlots + iSlot;
+    this->occupied[iLevel] |= (uint64_t)1 << iSlot;
+    this->nTimers++;
+}
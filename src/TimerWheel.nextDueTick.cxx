@@ -0,0 +1,76 @@
+/**
+ * TimerWheel.nextDueTick.cxx
+ */
+
+
+
+#include <cstdint>
+#ifdef _WIN32
+#include <intrin.h>
+#endif
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * lowestSetBit
+ * 
+ * Return Value: Returns the index of the lowest set bit of mask, which 
+ *               mustn't be 0.
+ */
+static int lowestSetBit(uint64_t mask) {
+#ifdef _WIN32
+    unsigned long iBit;
+    _BitScanForward64(&iBit, mask);
+    return (int)iBit;
+#else
+    return __builtin_ctzll(mask);
+#endif
+}
+
+
+
+/**
+ * TimerWheel::nextDueTick
+ * 
+ * Call it with lock held.
+ * 
+ * Return Value: Returns the first tick from curTick on at which a timer
+ *               fires or a slot holding timers must be cascaded, 
+ *               UINT64_MAX if the wheel is empty.
+ */
+uint64_t TimerWheel::nextDueTick() {
+
+    if (this->nTimers == 0)
+        return UINT64_MAX;
+
+    // Slots behind the current one are empty at every level, so the first
+    // occupied slot from the current one on is the next one due. On level 
+    // 0 that's when its timers fire, above that when it's cascaded.
+    uint64_t dueTick = UINT64_MAX;
+    for (int iLevel = 0; iLevel < timerWheelLevels; iLevel++) {
+
+        int shift = timerWheelBits * iLevel;
+        int iCurSlot = (int)(this->curTick >> shift) & (timerWheelSlots - 1);
+        uint64_t ahead = this->occupied[iLevel] & (~(uint64_t)0 << iCurSlot);
+        if (ahead == 0)
+            continue;
+
+        uint64_t blockStart = 
+            (this->curTick >> (shift + timerWheelBits)) << 
+                (shift + timerWheelBits);
+        uint64_t tick = blockStart + ((uint64_t)lowestSetBit(ahead) << shift);
+        if (tick < this->curTick) {
+            tick = this->curTick;
+        }
+        if (tick < dueTick) {
+            dueTick = tick;
+        }
+    }
+
+    return dueTick;
+}
@@ -0,0 +1,46 @@
+/**
+ * TimerWheel.remove.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * TimerWheel::remove
+ * 
+ * Unlinks an armed timer from its slot. The caller takes over the 
+ * timer's wheel reference. Call it with lock held.
+ * 
+ * timer: Armed timer to unlink.
+ */
+void TimerWheel::remove(Timer *timer) {
+
+    int iLevel = timer->iSlot / timerWheelSlots;
+    int iSlot = timer->iSlot % timerWheelSlots;
+
+    if (timer->prev != nullptr) {
+        timer->prev->next = timer->next;
+    }
+    else {
+        this->slots[iLevel][iSlot] = timer->next;
+    }
+    if (timer->next != nullptr) {
+        timer->next->prev = timer->prev;
+    }
+
+    if (this->slots[iLevel][iSlot] == nullptr) {
+        this->occupied[iLevel] &= ~((uint64_t)1 << iSlot);
+    }
+
+    timer->prev = nullptr;
+    timer->next = nullptr;
+    timer->iSlot = -1;
+    this->nTimers--;
+}
@@ -0,0 +1,30 @@
+/**
+ * TimerWheel.updateDue.cxx
+ */
+
+
+
+#include <cstdint>
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * TimerWheel::updateDue
+ * 
+ * Sets dueNs from nextDueTick. Call it with lock held.
+ */
+void TimerWheel::updateDue() {
+
+    uint64_t dueTick = this->nextDueTick();
+
+    // seq_cst: see Winpool::addTimer
+    this->dueNs.store(
+        dueTick == UINT64_MAX ? UINT64_MAX : dueTick * timerTickNs, 
+        std::memory_order_seq_cst
+    );
+}
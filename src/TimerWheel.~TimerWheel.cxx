@@ -0,0 +1,22 @@
+/**
+ * TimerWheel.~TimerWheel.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * TimerWheel destructor
+ * 
+ * Disarms the timers still in the wheel, without firing them.
+ */
+TimerWheel::~TimerWheel() {
+    this->clear();
+}
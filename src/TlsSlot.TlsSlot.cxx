@@ -0,0 +1,35 @@
+
+/**
+ * TlsSlot.TlsSlot.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+#ifndef _WIN32
+thread_local const TlsSlot *TlsSlot::tlsOwner = nullptr;
+thread_local void *TlsSlot::tlsValue = nullptr;
+#endif
+
+
+
+/**
+ * TlsSlot constructor
+ *
+ * Throws a SyscallError if no thread-local slot can be allocated.
+ */
+TlsSlot::TlsSlot() {
+#ifdef _WIN32
+    this->index = TlsAlloc();
+    if (this->index == TLS_OUT_OF_INDEXES) {
+        throw SyscallError(lastErrorCode());
+    }
+#endif
+}
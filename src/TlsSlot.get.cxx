@@ -0,0 +1,28 @@
+
+/**
+ * TlsSlot.get.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * TlsSlot::get
+ *
+ * Return Value: Returns the calling thread's value for this slot, nullptr
+ *               if the thread never set one.
+ */
+void *TlsSlot::get() const {
+#ifdef _WIN32
+    return TlsGetValue(this->index);
+#else
+    return tlsOwner == this ? tlsValue : nullptr;
+#endif
+}
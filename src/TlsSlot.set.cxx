@@ -0,0 +1,32 @@
+
+/**
+ * TlsSlot.set.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * TlsSlot::set
+ *
+ * Sets the calling thread's value for this slot.
+ * Throws a SyscallError on failure.
+ */
+void TlsSlot::set(void *value) {
+#ifdef _WIN32
+    BOOL boolRc = TlsSetValue(this->index, value);
+    if (!boolRc) {
+        throw SyscallError(lastErrorCode());
+    }
+#else
+    tlsOwner = this;
+    tlsValue = value;
+#endif
+}
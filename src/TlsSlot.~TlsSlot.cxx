@@ -0,0 +1,28 @@
+
+/**
+ * TlsSlot.~TlsSlot.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+/**
+ * TlsSlot destructor
+ *
+ * Frees the slot.
+ */
+WinpoolNS::TlsSlot::~TlsSlot() {
+#ifdef _WIN32
+    TlsFree(this->index);
+#else
+    // Threads that set a value for this slot are gone by now, but the 
+    // destroying thread may be one of them
+    if (tlsOwner == this) {
+        tlsOwner = nullptr;
+        tlsValue = nullptr;
+    }
+#endif
+}
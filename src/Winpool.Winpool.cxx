@@ -6,6 +6,9 @@
 
 
 #include <memory>
+#include <cstdlib>
+#include <vector>
+#include <algorithm>
 #include <iso646.h>
 #include "_winpool_private.hxx"
 
@@ -21,11 +24,11 @@ using namespace WinpoolNS;
  * Just sets the members.
  */
 WorkerTProcData::WorkerTProcData(Winpool *pool, 
-                                 DWORD tlsMyWorkerIdx, 
+                                 TlsSlot *workerTls, 
                                  Worker *myWorker) {
 
     this->pool = pool;
-    this->tlsMyWorkerIdx = tlsMyWorkerIdx;
+    this->workerTls = workerTls;
     this->myWorker = myWorker;
 }
 
@@ -34,72 +37,89 @@ WorkerTProcData::WorkerTProcData(Winpool *pool,
 /**
  * Winpool constructor
  * 
- * Initializes a new Winpool instance and starts up its worker threads.
+ * Initializes a new Winpool instance, places its workers on the CPUs 
+ * (see createNew) and starts up its worker threads.
  * 
  * nThreads: The number of worker threads to spawn.
+ * maxThreads: The number of worker slots, at least nThreads.
  */
-Winpool::Winpool(int nThreads) :
-         futures() {
-
-    BOOL boolRc;
-    DWORD errorCode;
+Winpool::Winpool(int nThreads, int maxThreads) :
+         futures(),
+         taskQueue(),
+         workerTls(),
+         idleWorkers(),
+         timers() {
+
+    ErrorCode errorCode;
     int iWorker = 0;
     
-    this->nWorkers = nThreads;
+    this->nWorkers = maxThreads;
+    this->nStarted.store(0, std::memory_order_relaxed);
+    this->nBaseWorkers.store(nThreads, std::memory_order_relaxed);
+    this->nBlocking.store(0, std::memory_order_relaxed);
+    this->nIdle.store(0, std::memory_order_relaxed);
+    this->aborting.store(false, std::memory_order_relaxed);
+    this->shutDown.store(false, std::memory_order_relaxed);
     this->lock = &this->futures.lock;
-    this->hWorkerThreads = UniquePtr<HANDLE[]>(new HANDLE[nThreads]);
-    this->workers = UniquePtr<Worker[]>(new Worker[nThreads]);
+    this->workerThreads = UniquePtr<Thread[]>(new Thread[maxThreads]);
+    this->workers = UniquePtr<Worker[]>(new Worker[maxThreads]);
     this->workerDatas = UniquePtr<WorkerTProcData[]>(
-        (WorkerTProcData *)malloc(sizeof(WorkerTProcData) * nThreads)
+        (WorkerTProcData *)malloc(sizeof(WorkerTProcData) * maxThreads)
     );
-
-    // Allocate Tls worker variable
-    DWORD tlsMyWorkerIdx = TlsAlloc();
-    if (tlsMyWorkerIdx < 0) {
-        errorCode = GetLastError();
-        goto onError;
-    }
-    boolRc = TlsSetValue(tlsMyWorkerIdx, nullptr);
-    if (!boolRc) {
-        errorCode = GetLastError();
-        goto onError;
-    }
-    this->workerTlsIdx = tlsMyWorkerIdx;
-
-    // Start the worker threads
-    for (iWorker = 0; iWorker < nThreads; iWorker++) {
+    for (iWorker = 0; iWorker < maxThreads; iWorker++) {
         this->workerDatas[iWorker] = WorkerTProcData(
             this, 
-            tlsMyWorkerIdx,
+            &this->workerTls,
             this->workers.get() + iWorker
         );
-        this->hWorkerThreads[iWorker] = CreateThread(
-            NULL,
-            0,
-            workerTProc,
-            (LPVOID)(&this->workerDatas.get()[iWorker]),
-            0,
-            NULL
-        );
-        if (this->hWorkerThreads[iWorker] == INVALID_HANDLE_VALUE) {
-            errorCode = GetLastError();
-            goto onError;
-        }
     }
 
-    this->running = true;
+    // Consecutive workers fill a cluster, then a node, before spilling 
+    // over to the next one. If there are more workers than CPUs, pinning 
+    // would just stack them up, so they're only grouped for stealing. 
+    // Slots past the CPU count (only used to compensate for blocked 
+    // workers) are never pinned.
+    std::vector<CpuPlace> cpus = discoverCpus();
+    bool pinWorkers = !cpus.empty() && (size_t)nThreads <= cpus.size();
+    this->nPinned = pinWorkers 
+                    ? (int)std::min((size_t)maxThreads, cpus.size()) 
+                    : 0;
+    for (iWorker = 0; iWorker < maxThreads; iWorker++) {
+        if (!cpus.empty()) {
+            this->workers[iWorker].place = cpus[iWorker % cpus.size()];
+        }
+    }
+    planStealing(this->workers.get(), maxThreads);
+
+    // Workers exit as soon as they see running == false, so this has to be
+    // set before any of them start
+    this->running.store(true, std::memory_order_release);
+
+    // Start the worker threads. The other slots get theirs when needed.
+    try {
+        for (iWorker = 0; iWorker < nThreads; iWorker++) {
+            this->workers[iWorker].state.store(
+                WORKER_ACTIVE, 
+                std::memory_order_relaxed
+            );
+            this->startWorker(iWorker);
+        }
+    }
+    catch (SyscallError e) {
+        errorCode = e.error;
+        goto onError;
+    }
 
     return;
 
 onError:
+    this->running.store(false, std::memory_order_release);
+    this->idleWorkers.notifyAll();
     for (int i = 0; i < iWorker; i++) {
-        TerminateThread(this->hWorkerThreads[i], errorCode);
-        WaitForSingleObject(this->hWorkerThreads[i], INFINITE);
-        CloseHandle(this->hWorkerThreads[i]);
+        this->workerThreads[i].join();
     }
-    this->hWorkerThreads.reset(nullptr);
+    this->workerThreads.reset(nullptr);
     this->workers.reset(nullptr);
     this->workerDatas.reset(nullptr);
-    TlsFree(tlsMyWorkerIdx);
     throw SyscallError(errorCode);
 }
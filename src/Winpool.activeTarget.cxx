@@ -0,0 +1,31 @@
+
+/**
+ * Winpool.activeTarget.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * Winpool::activeTarget
+ * 
+ * Return Value: Returns how many workers should be running right now: 
+ *               nBaseWorkers plus one per blocked worker, at most 
+ *               nWorkers.
+ */
+int Winpool::activeTarget() {
+
+    // seq_cst: pairs with the seq_cst state stores of parking workers (see
+    // adjustWorkers)
+    int target = this->nBaseWorkers.load(std::memory_order_seq_cst) 
+               + this->nBlocking.load(std::memory_order_seq_cst);
+
+    return target < this->nWorkers ? target : this->nWorkers;
+}
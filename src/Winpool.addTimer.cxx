@@ -0,0 +1,59 @@
+/**
+ * Winpool.addTimer.cxx
+ */
+
+
+
+#include <utility>
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * Winpool::addTimer
+ * 
+ * Arms a timer running task after delayNs, then every periodNs if that
+ * isn't 0. If its deadline is earlier than any idle worker will wake up
+ * for, wakes one up to keep time.
+ * 
+ * task: Callable to run.
+ * delayNs: Delay before the first run.
+ * periodNs: Time between runs, 0 for a single run.
+ * 
+ * Return Value: Returns a handle for cancelling the timer.
+ */
+TimerHandle Winpool::addTimer(TimerTask task, 
+                              uint64_t delayNs, 
+                              uint64_t periodNs) {
+
+    // Round up to whole ticks so nothing fires early
+    uint64_t periodTicks = (periodNs + timerTickNs - 1) / timerTickNs;
+    if (periodNs != 0 && periodTicks == 0) {
+        periodTicks = 1;
+    }
+    Timer *timer = new Timer(this, std::move(task), periodTicks);
+    timer->deadlineTick = 
+        (monotonicNs() + delayNs + timerTickNs - 1) / timerTickNs;
+
+    TimerWheel *wheel = &this->timers;
+    wheel->lock.enter();
+    wheel->insert(timer);
+    wheel->updateDue();
+    uint64_t dueNs = wheel->dueNs.load(std::memory_order_relaxed);
+    wheel->lock.leave();
+
+    // Idle workers check dueNs (seq_cst) after registering as waiters, 
+    // before they pick a timeout; we stored it (seq_cst) before checking 
+    // keeperWakeNs and for waiters. So either a worker going to sleep sees
+    // the new deadline or we see it waiting and wake one up, which then 
+    // keeps time.
+    if (dueNs < wheel->keeperWakeNs.load(std::memory_order_seq_cst)) {
+        this->idleWorkers.notifyOne();
+    }
+
+    return TimerHandle(timer);
+}
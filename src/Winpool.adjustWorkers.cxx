@@ -0,0 +1,61 @@
+
+/**
+ * Winpool.adjustWorkers.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * Winpool::adjustWorkers
+ * 
+ * Starts or unparks every worker below activeTarget. Workers above it 
+ * retire on their own.
+ */
+void Winpool::adjustWorkers() {
+
+    // A worker parks by storing WORKER_PARKED, then re-checking the target.
+    // We changed the target before loading its state (all seq_cst), so 
+    // either it sees the new target and stays, or we see it parked.
+    int target = this->activeTarget();
+    for (int iWorker = 0; iWorker < target; iWorker++) {
+
+        Worker *worker = &this->workers[iWorker];
+        uint32_t state = worker->state.load(std::memory_order_seq_cst);
+
+        if (state == WORKER_PARKED) {
+            if (worker->state.compare_exchange_strong(
+                    state, 
+                    WORKER_ACTIVE, 
+                    std::memory_order_seq_cst)) {
+                wakeAddressOne(&worker->state);
+            }
+        }
+        else if (state == WORKER_UNSTARTED) {
+            if (!worker->state.compare_exchange_strong(
+                    state, 
+                    WORKER_ACTIVE, 
+                    std::memory_order_seq_cst)) {
+                continue;
+            }
+            // No thread to be had: make do with the workers we have
+            try {
+                this->startWorker(iWorker);
+            }
+            catch (SyscallError e) {
+                worker->state.store(
+                    WORKER_UNSTARTED, 
+                    std::memory_order_seq_cst
+                );
+                return;
+            }
+        }
+    }
+}
@@ -0,0 +1,33 @@
+
+/**
+ * Winpool.allocatorStats.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * Winpool::allocatorStats
+ * 
+ * Sums up the Future allocator counters of all workers. Safe to call 
+ * while the pool is running; the counters are only a snapshot then.
+ * 
+ * Return Value: Returns the summed counters.
+ */
+AllocatorStats Winpool::allocatorStats() {
+
+    AllocatorStats stats = { 0, 0, 0, 0 };
+
+    for (int iWorker = 0; iWorker < this->nWorkers; iWorker++) {
+        this->workers[iWorker].slab->collectStats(&stats);
+    }
+
+    return stats;
+}
@@ -0,0 +1,36 @@
+/**
+ * Winpool.cancelRequested.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * Winpool::cancelRequested
+ * 
+ * Lets a long-running task check whether it should stop early. A TLS 
+ * read and a couple of relaxed loads, so it's cheap enough to poll in a loop.
+ * 
+ * Return Value: Returns true if the calling task runs on one of this 
+ *               pool's workers under a cancelled token, or while 
+ *               the pool shuts down in SHUTDOWN_FAST mode.
+ */
+bool Winpool::cancelRequested() {
+
+    Worker *myWorker = (Worker *)this->workerTls.get();
+    if (myWorker == nullptr)
+        return false;
+
+    if (this->aborting.load(std::memory_order_relaxed))
+        return true;
+
+    return myWorker->bToken != nullptr && 
+           myWorker->bToken->cancelled.load(std::memory_order_relaxed);
+}
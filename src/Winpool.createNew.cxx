@@ -19,6 +19,10 @@ using namespace WinpoolNS;
  * 
  * Creates and initializes a Winpool instance on the heap, starts up the 
  * worker threads, passes ownership of this instance to the caller.
+ * Workers are spread over the CPUs the process may use, filling a 
+ * cluster (CPUs sharing a last level cache) and then a NUMA node before 
+ * moving on, pinned if there are at least as many CPUs as workers. They 
+ * steal from their own cluster first, then their node, then the rest.
  * 
  * nThreads: Number of worker threads to spawn.
  * 
@@ -26,7 +30,27 @@ using namespace WinpoolNS;
  *               that holds ownership of it.
  */
 UniquePtr<Winpool> Winpool::createNew(int nThreads) {
+    return createNew(nThreads, nThreads * workerHeadroom);
+}
+
+
 
-    UniquePtr<Winpool> poolPtr = UniquePtr<Winpool>(new Winpool(nThreads));
-    return std::move(poolPtr);
+/**
+ * Winpool::createNew
+ * 
+ * Like createNew(nThreads), with room for up to maxThreads workers instead
+ * of workerHeadroom * nThreads.
+ * 
+ * nThreads: Number of worker threads to spawn.
+ * maxThreads: Most workers the pool will ever run at once, counting 
+ *             compensating ones. Raised to nThreads if lower.
+ * 
+ * Return Value: Returns a pointer to the newly created Winpool instance
+ *               that holds ownership of it.
+ */
+UniquePtr<Winpool> Winpool::createNew(int nThreads, int maxThreads) {
+    if (maxThreads < nThreads) {
+        maxThreads = nThreads;
+    }
+    return UniquePtr<Winpool>(new Winpool(nThreads, maxThreads));
 }
@@ -0,0 +1,38 @@
+
+/**
+ * Winpool.enterBlocking.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * Winpool::enterBlocking
+ * 
+ * Counts the calling worker as blocked and brings in a worker to 
+ * compensate. See BlockingRegion.
+ * 
+ * Return Value: Returns false (and does nothing) if the calling thread 
+ *               isn't one of the pool's workers.
+ */
+bool Winpool::enterBlocking() {
+
+    Worker *myWorker = (Worker *)this->workerTls.get();
+    if (myWorker == nullptr)
+        return false;
+
+    // Only the outermost region counts
+    if (myWorker->blockingDepth++ == 0) {
+        this->nBlocking.fetch_add(1, std::memory_order_seq_cst);
+        this->adjustWorkers();
+    }
+
+    return true;
+}
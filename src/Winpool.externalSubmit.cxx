@@ -6,7 +6,6 @@
 
 
 #include <memory>
-#include <windows.h>
 #include "_winpool_private.hxx"
 
 
@@ -18,26 +17,23 @@ using namespace WinpoolNS;
 /**
  * Winpool::externalSubmit
  * 
- * Helper function for submit() that is called when submit is invoked by an
- * external thread.
- * Places the task on the pool's queue.
+ * Helper function for submitFuture() that is called when it is invoked
+ * by an external thread, or for a Future with a priority.
+ * Places the task in its lane of the pool's queue.
  * 
- * func: Function to execute.
- * arg: Argument to pass to func.
+ * fut: Future to queue, with ownership passed to this function.
  * 
  * Return Value: Returns a borrowed pointer to a Future that can be used
  *               to get the task's result in the future.
  */
-Future *Winpool::externalSubmit(WinpoolTask func, void *arg) {
+Future *Winpool::externalSubmit(UniquePtr<Future> fut) {
     
-    UniquePtr<Future> uFuture = UniquePtr<Future>(
-        new Future(func, arg, this, &this->futures)
-    );
-    Future *bFuture = uFuture.get();
-
-    EnterCriticalSection(this->lock);
-    this->futures.taskQueue.insertTail(std::move(uFuture));
-    LeaveCriticalSection(this->lock);
+    Future *bFuture = fut.get();
+    bFuture->owner = &this->futures;
+
+    this->taskQueue.push(std::move(fut));
+
+    this->idleWorkers.notifyOne();
 
     return bFuture;
 }
@@ -0,0 +1,36 @@
+
+/**
+ * Winpool.joinStats.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * Winpool::joinStats
+ * 
+ * Sums up the join counters of all workers. Safe to call while the pool
+ * is running; the counters are only a snapshot then.
+ * 
+ * Return Value: Returns the summed counters.
+ */
+JoinStats Winpool::joinStats() {
+
+    JoinStats stats = { 0, 0, 0 };
+    for (int iWorker = 0; iWorker < this->nWorkers; iWorker++) {
+        Worker *bWorker = &this->workers[iWorker];
+        stats.nWaits += bWorker->nJoinWaits.load(std::memory_order_relaxed);
+        stats.nHelps += bWorker->nJoinHelps.load(std::memory_order_relaxed);
+        stats.wastedNs += 
+            bWorker->joinWastedNs.load(std::memory_order_relaxed);
+    }
+
+    return stats;
+}
@@ -0,0 +1,29 @@
+
+/**
+ * Winpool.leaveBlocking.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * Winpool::leaveBlocking
+ * 
+ * Undoes a successful enterBlocking. The compensating worker retires on 
+ * its own.
+ */
+void Winpool::leaveBlocking() {
+
+    Worker *myWorker = (Worker *)this->workerTls.get();
+
+    if (--myWorker->blockingDepth == 0) {
+        this->nBlocking.fetch_sub(1, std::memory_order_seq_cst);
+    }
+}
@@ -0,0 +1,63 @@
+/**
+ * Winpool.runTimers.cxx
+ */
+
+
+
+#include <cstdint>
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * Winpool::runTimers
+ * 
+ * If the timer wheel is due and no other worker is advancing it, 
+ * advances it and spawns the tasks of the timers that fired. Costs one
+ * load when no timers are armed.
+ */
+void Winpool::runTimers() {
+
+    TimerWheel *wheel = &this->timers;
+
+    uint64_t dueNs = wheel->dueNs.load(std::memory_order_relaxed);
+    if (dueNs == UINT64_MAX)
+        return;
+    uint64_t nowNs = monotonicNs();
+    if (nowNs < dueNs)
+        return;
+
+    if (wheel->busy.load(std::memory_order_relaxed) || 
+            wheel->busy.exchange(true, std::memory_order_acquire)) {
+        return;
+    }
+    uint64_t lockStartNs = monotonicNs();
+    wheel->lock.enter();
+    Worker *myWorker = (Worker *)this->workerTls.get();
+    if (myWorker != nullptr) {
+        bumpCounter(&myWorker->lockWaitNs, monotonicNs() - lockStartNs);
+    }
+    Timer *fired = wheel->advance(nowNs / timerTickNs);
+    wheel->lock.leave();
+    wheel->busy.store(false, std::memory_order_release);
+
+    // Spawned outside the lock, so cancel and addTimer never wait on 
+    // queueing; each task owns its firing's reference
+    while (fired != nullptr) {
+        Timer *timer = fired;
+        fired = timer->fireNext;
+        this->spawn([timer]() {
+            try {
+                timer->task();
+            }
+            catch (TaskCancelled &) {
+                // The firing is over either way
+            }
+            timer->release();
+        });
+    }
+}
@@ -0,0 +1,37 @@
+
+/**
+ * Winpool.setWorkerCount.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * Winpool::setWorkerCount
+ * 
+ * Grows or shrinks the set of running workers while the pool runs. New 
+ * workers start (or unpark) right away; extra ones retire once they've 
+ * emptied their own deque, parking so they cost nothing until they're 
+ * needed again.
+ * 
+ * nThreads: Number of workers to run, clamped to [1, nWorkers].
+ */
+void Winpool::setWorkerCount(int nThreads) {
+
+    if (nThreads < 1) {
+        nThreads = 1;
+    }
+    if (nThreads > this->nWorkers) {
+        nThreads = this->nWorkers;
+    }
+
+    this->nBaseWorkers.store(nThreads, std::memory_order_seq_cst);
+    this->adjustWorkers();
+}
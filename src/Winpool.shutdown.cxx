@@ -1,11 +1,9 @@
-
 /**
  * Winpool.shutdown.cxx
  */
 
 
 
-#include <windows.h>
 #include <memory>
 #include "_winpool_private.hxx"
 
@@ -15,6 +13,96 @@ using namespace WinpoolNS;
 
 
 
-bool Winpool::shutdown() {
-    
+/**
+ * allIdle
+ * 
+ * Has every started worker gone to sleep with nothing left to run? Only 
+ * workers submit while shutdown waits, and they never go idle leaving 
+ * work behind, so this holds for good once it holds at all. The queues 
+ * and idleWorkers' epoch are checked too, in case a worker was woken for
+ * a task but hasn't left nIdle yet.
+ */
+static bool allIdle(Winpool *pool) {
+
+    uint32_t epoch = pool->idleWorkers.epoch.load(std::memory_order_seq_cst);
+    int nStarted = pool->nStarted.load(std::memory_order_seq_cst);
+    if (pool->nIdle.load(std::memory_order_seq_cst) != (uint32_t)nStarted)
+        return false;
+
+    if (!pool->taskQueue.empty())
+        return false;
+    for (int iWorker = 0; iWorker < nStarted; iWorker++) {
+        if (!pool->workers[iWorker].taskQueue.empty())
+            return false;
+    }
+
+    return pool->nIdle.load(std::memory_order_seq_cst) == 
+               (uint32_t)nStarted && 
+           pool->idleWorkers.epoch.load(std::memory_order_seq_cst) == epoch;
+}
+
+
+
+/**
+ * Winpool::shutdown
+ * 
+ * Stops the pool: disarms its timers, lets the workers finish the 
+ * queued tasks (SHUTDOWN_DRAIN) or skips the cancellable ones among
+ * them (SHUTDOWN_FAST), then joins every worker thread once they're 
+ * all out of work. Tasks already running always finish; in fast mode
+ * cancelRequested tells them to hurry up. Don't submit from other 
+ * threads in the meantime. Only the first call does anything, and not
+ * from one of the pool's own workers, which can't join themselves. 
+ * The destructor drains if nobody shut the pool down before.
+ * 
+ * mode: What to do with the tasks that haven't started.
+ * 
+ * Return Value: Returns true if this call shut the pool down.
+ */
+bool Winpool::shutdown(ShutdownMode mode) {
+
+    if (this->workerTls.get() != nullptr)
+        return false;
+    if (this->shutDown.exchange(true, std::memory_order_seq_cst))
+        return false;
+
+    // Skipped tasks still complete, so nobody waiting on one is stranded
+    if (mode == SHUTDOWN_FAST) {
+        this->aborting.store(true, std::memory_order_seq_cst);
+    }
+
+    // Nothing fires from now on
+    this->timers.lock.enter();
+    this->timers.clear();
+    this->timers.lock.leave();
+
+    // Let the workers run out of work. The last one to go idle wakes us 
+    // up; the timeout only bounds how long a missed wakeup could cost.
+    while (!allIdle(this)) {
+        uint32_t nIdle = this->nIdle.load(std::memory_order_seq_cst);
+        waitOnAddressFor(&this->nIdle, nIdle, shutdownPollNs);
+    }
+
+    // Then send them home: sleeping workers see running == false once 
+    // woken, parked ones once unparked (see parkWorker). Slots that never
+    // got a thread have nothing to join.
+    this->running.store(false, std::memory_order_seq_cst);
+    this->idleWorkers.notifyAll();
+
+    int nStarted = this->nStarted.load(std::memory_order_acquire);
+    for (int iWorker = 0; iWorker < nStarted; iWorker++) {
+        Worker *worker = &this->workers[iWorker];
+        uint32_t parked = WORKER_PARKED;
+        if (worker->state.compare_exchange_strong(
+                parked, 
+                WORKER_ACTIVE, 
+                std::memory_order_seq_cst)) {
+            wakeAddressOne(&worker->state);
+        }
+    }
+    for (int iWorker = 0; iWorker < nStarted; iWorker++) {
+        this->workerThreads[iWorker].join();
+    }
+
+    return true;
 }
@@ -0,0 +1,49 @@
+
+/**
+ * Winpool.startWorker.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * Winpool::startWorker
+ * 
+ * Starts the thread of slot iWorker, pinning it if the slot is below 
+ * nPinned. The slot's state must already be WORKER_ACTIVE.
+ * Throws a SyscallError if the thread can't be created.
+ * 
+ * iWorker: Index of the slot.
+ */
+void Winpool::startWorker(int iWorker) {
+
+    this->workerThreads[iWorker].start(
+        workerTProc,
+        (void *)(&this->workerDatas.get()[iWorker])
+    );
+
+    // Not being able to pin only costs locality
+    if (iWorker < this->nPinned) {
+        this->workerThreads[iWorker].pinToCpu(
+            this->workers[iWorker].place.cpu
+        );
+    }
+
+    // Let thieves look at the new worker's deque
+    int nStarted = this->nStarted.load(std::memory_order_relaxed);
+    while (nStarted < iWorker + 1 && 
+           !this->nStarted.compare_exchange_weak(
+               nStarted, 
+               iWorker + 1, 
+               std::memory_order_release, 
+               std::memory_order_relaxed)) {
+        // nStarted was reloaded
+    }
+}
@@ -0,0 +1,79 @@
+/**
+ * Winpool.stats.cxx
+ */
+
+
+
+#include <vector>
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * loadCounter
+ *
+ * Reads one of a worker's counters. Relaxed is enough: they're independent
+ * and only written by their worker.
+ */
+static uint64_t loadCounter(const std::atomic<uint64_t> &counter) {
+    return counter.load(std::memory_order_relaxed);
+}
+
+
+
+/**
+ * Winpool::stats
+ *
+ * Collects the scheduler counters of every started worker, and their
+ * sum. Safe to call while the pool is running; the counters are only
+ * a snapshot then.
+ *
+ * Return Value: Returns the counters.
+ */
+SchedulerStats Winpool::stats() {
+
+    SchedulerStats stats;
+    stats.total = {};
+
+    int nStarted = this->nStarted.load(std::memory_order_acquire);
+    stats.workers.reserve(nStarted);
+    for (int iWorker = 0; iWorker < nStarted; iWorker++) {
+        Worker *bWorker = &this->workers[iWorker];
+
+        WorkerStats counters;
+        counters.nTasks = loadCounter(bWorker->nTasks);
+        counters.nCancelled = loadCounter(bWorker->nCancelled);
+        counters.nQueuePops = loadCounter(bWorker->nQueuePops);
+        counters.nStealAttempts = loadCounter(bWorker->nStealAttempts);
+        counters.nSteals = loadCounter(bWorker->nSteals);
+        counters.nYields = loadCounter(bWorker->nYields);
+        counters.nSleeps = loadCounter(bWorker->nSleeps);
+        counters.sleepNs = loadCounter(bWorker->sleepNs);
+        counters.parkedNs = loadCounter(bWorker->parkedNs);
+        counters.nJoinWaits = loadCounter(bWorker->nJoinWaits);
+        counters.joinNs = loadCounter(bWorker->joinNs);
+        counters.joinWastedNs = loadCounter(bWorker->joinWastedNs);
+        counters.lockWaitNs = loadCounter(bWorker->lockWaitNs);
+        stats.workers.push_back(counters);
+
+        stats.total.nTasks += counters.nTasks;
+        stats.total.nCancelled += counters.nCancelled;
+        stats.total.nQueuePops += counters.nQueuePops;
+        stats.total.nStealAttempts += counters.nStealAttempts;
+        stats.total.nSteals += counters.nSteals;
+        stats.total.nYields += counters.nYields;
+        stats.total.nSleeps += counters.nSleeps;
+        stats.total.sleepNs += counters.sleepNs;
+        stats.total.parkedNs += counters.parkedNs;
+        stats.total.nJoinWaits += counters.nJoinWaits;
+        stats.total.joinNs += counters.joinNs;
+        stats.total.joinWastedNs += counters.joinWastedNs;
+        stats.total.lockWaitNs += counters.lockWaitNs;
+    }
+
+    return stats;
+}
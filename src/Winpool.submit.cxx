@@ -30,12 +30,9 @@ using namespace WinpoolNS;
  */
 Future *Winpool::submit(WinpoolTask func, void *arg) {
     
-    Worker *myWorker = (Worker *)TlsGetValue(this->workerTlsIdx);
-
-    if (myWorker == nullptr) {
-        return this->externalSubmit(func, arg);
-    }
-    else {
-        return this->workerSubmit(func, arg, myWorker);
-    }
+    UniquePtr<Future> uFuture = UniquePtr<Future>(
+        new Future(std::move(func), arg, this, nullptr)
+    );
+    uFuture->cancellable = true;
+    return this->submitFuture(std::move(uFuture));
 }
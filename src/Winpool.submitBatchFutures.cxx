@@ -0,0 +1,58 @@
+/**
+ * Winpool.submitBatchFutures.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * Winpool::submitBatchFutures
+ * 
+ * Queues all Futures of a batch built by submitBatch: on the calling 
+ * worker's deque with one store, or on the pool's queue with one 
+ * exchange, then wakes up to nTasks idle workers.
+ * 
+ * batch: Batch whose Futures to queue. Ownership of the Futures is 
+ *        passed to the pool.
+ */
+void Winpool::submitBatchFutures(FutureBatch *batch) {
+
+    uint32_t nTasks = batch->nTasks;
+    if (nTasks == 0)
+        return;
+
+    Worker *myWorker = (Worker *)this->workerTls.get();
+    FutureOwner *owner = myWorker != nullptr ? myWorker 
+                                   : &this->futures;
+
+    for (uint32_t iTask = 0; iTask < nTasks; iTask++) {
+        Future *fut = batch->futureAt(iTask);
+        fut->owner = owner;
+    }
+
+    if (myWorker != nullptr) {
+        myWorker->taskQueue.pushBatch(batch);
+    }
+    else {
+        // Chain the Futures up so the whole batch goes in with one exchange
+        for (uint32_t iTask = 0; iTask + 1 < nTasks; iTask++) {
+            batch->futureAt(iTask)->queueNext.store(
+                batch->futureAt(iTask + 1), 
+                std::memory_order_relaxed
+            );
+        }
+        this->taskQueue.pushChain(
+            batch->futureAt(0), 
+            batch->futureAt(nTasks - 1)
+        );
+    }
+
+    this->idleWorkers.notifyMany(nTasks);
+}
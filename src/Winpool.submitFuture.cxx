@@ -0,0 +1,48 @@
+
+/**
+ * Winpool.submitFuture.cxx
+ */
+
+
+
+#include <memory>
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * Winpool::submitFuture
+ * 
+ * Queues a Future that already has its task. Worker threads put it on 
+ * their own deque, external threads (and anything not PRIORITY_NORMAL)
+ * in its lane of the pool's queue. A Future without a token submitted
+ * from a task running under one inherits it.
+ * 
+ * fut: Future created with the task-less constructor, with ownership 
+ *      passed to this function.
+ * 
+ * Return Value: Returns a borrowed pointer to fut, owned by the pool 
+ *               until completion.
+ */
+Future *Winpool::submitFuture(UniquePtr<Future> fut) {
+    
+    Worker *myWorker = (Worker *)this->workerTls.get();
+
+    if (myWorker != nullptr && 
+            myWorker->bToken != nullptr && 
+            fut->token == nullptr) {
+        fut->token = myWorker->bToken;
+        fut->token->addRef();
+    }
+
+    if (myWorker == nullptr || fut->priority != PRIORITY_NORMAL) {
+        return this->externalSubmit(std::move(fut));
+    }
+    else {
+        return this->workerSubmit(std::move(fut), myWorker);
+    }
+}
@@ -17,28 +17,24 @@ using namespace WinpoolNS;
 /**
  * Winpool::workerSubmit
  * 
- * Helper function for submit() that is called when submit is invoked by a 
- * worker thread.
+ * Helper function for submitFuture() that is called when it is invoked
+ * by a worker thread.
  * Places the task on the worker's queue instead of on the pool's.
  * 
- * func: Functionto execute.
- * arg: Argument to pass to func.
+ * fut: Future to queue, with ownership passed to this function.
  * worker: Points to the Worker object with info about the invoking worker
  *         thread.
  * 
  * Return Value: Returns a borrowed pointer to a Future that can be used
  *               to get the task's result in the future.
  */
-Future *Winpool::workerSubmit(WinpoolTask func, void *arg, Worker *worker) {
+Future *Winpool::workerSubmit(UniquePtr<Future> fut, Worker *worker) {
     
-    UniquePtr<Future> uFuture = UniquePtr<Future>(
-        new Future(func, arg, this, worker)
-    );
-    Future *bFuture = uFuture.get();
-
-    EnterCriticalSection(bFuture->lock);
-    worker->taskQueue.insertHead(std::move(uFuture));
-    LeaveCriticalSection(bFuture->lock);
+    Future *bFuture = fut.get();
+    bFuture->owner = worker;
+
+    worker->taskQueue.push(std::move(fut));
+    this->idleWorkers.notifyOne();
 
     return bFuture;
 }
@@ -0,0 +1,25 @@
+/**
+ * Winpool.~Winpool.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * Winpool destructor
+ * 
+ * Shuts the pool down (draining it, unless shutdown was called before)
+ * and frees everything, its thread-local slot included.
+ */
+Winpool::~Winpool() {
+
+    // No worker is left to touch the members destroyed after this
+    this->shutdown(SHUTDOWN_DRAIN);
+}
@@ -5,8 +5,6 @@
 
 
 
-#include <windows.h>
-#include <iso646.h>
 #include <cstdio> // DELETE LATER
 #include "_winpool_private.hxx"
 
@@ -19,19 +17,44 @@ using namespace WinpoolNS;
 /**
  * Worker constructor
  * 
- * Initializes this instance with an empty taskQueue and completedList.
+ * Initializes this instance with an empty taskQueue.
  */
 Worker::Worker() : 
-        taskQueue(),
-        completedList() {
-
-    BOOL boolRc;
-
-    boolRc = InitializeCriticalSectionAndSpinCount(
-        &this->lock,
-        spinCount
-    );
-    if (not boolRc) {
-        throw SyscallError(GetLastError());
-    }
+        lock(),
+        taskQueue() {
+
+    this->slab = new FutureSlab();
+
+    // Seed the victim picker from our address: distinct for every worker
+    // (splitmix64 finalizer), and never 0, which xorshift can't leave
+    uint64_t z = (uint64_t)(uintptr_t)this + 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    this->rngState = (z ^ (z >> 31)) | 1;
+
+    // Until the pool places us, we're alone on CPU 0 and steal from nobody
+    this->place = CpuPlace{0, 0, 0};
+    this->nSameCluster = 0;
+    this->nSameNode = 0;
+
+    this->state.store(WORKER_UNSTARTED, std::memory_order_relaxed);
+    this->blockingDepth = 0;
+    this->joinDepth = 0;
+    this->bToken = nullptr;
+
+    this->joinVictim.store(nullptr, std::memory_order_relaxed);
+    this->nJoinWaits.store(0, std::memory_order_relaxed);
+    this->nJoinHelps.store(0, std::memory_order_relaxed);
+    this->joinWastedNs.store(0, std::memory_order_relaxed);
+    this->joinNs.store(0, std::memory_order_relaxed);
+    this->nTasks.store(0, std::memory_order_relaxed);
+    this->nCancelled.store(0, std::memory_order_relaxed);
+    this->nQueuePops.store(0, std::memory_order_relaxed);
+    this->nStealAttempts.store(0, std::memory_order_relaxed);
+    this->nSteals.store(0, std::memory_order_relaxed);
+    this->nYields.store(0, std::memory_order_relaxed);
+    this->nSleeps.store(0, std::memory_order_relaxed);
+    this->sleepNs.store(0, std::memory_order_relaxed);
+    this->parkedNs.store(0, std::memory_order_relaxed);
+    this->lockWaitNs.store(0, std::memory_order_relaxed);
 }
@@ -0,0 +1,30 @@
+
+/**
+ * Worker.nextRandom.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * Worker::nextRandom
+ * 
+ * Advances rngState. Only call this from the worker's own thread.
+ * 
+ * Return Value: Returns the next pseudo-random number.
+ */
+uint64_t Worker::nextRandom() {
+    uint64_t x = this->rngState;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    this->rngState = x;
+    return x * 0x2545F4914F6CDD1DULL;
+}
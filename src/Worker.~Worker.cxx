@@ -0,0 +1,20 @@
+
+/**
+ * Worker.~Worker.cxx
+ */
+
+
+
+#include "_winpool_private.hxx"
+
+
+
+/**
+ * Worker destructor
+ */
+WinpoolNS::Worker::~Worker() {
+
+    // Futures from our slab may outlive us (in other lists or held by the
+    // user), so the slab deletes itself once the last one is freed
+    this->slab->orphan();
+}
@@ -0,0 +1,193 @@
+/**
+ * discoverCpus.cxx
+ */
+
+
+
+#include <vector>
+#include <algorithm>
+#ifdef _WIN32
+#include <memory>
+#else
+#include <cstdio>
+#include <sched.h>
+#include <dirent.h>
+#endif
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+#ifdef _WIN32
+/**
+ * forEachCpu
+ *
+ * Calls func(cpu) for every CPU set in mask (numbered group * 64 + bit).
+ */
+template<class F>
+static void forEachCpu(const GROUP_AFFINITY &mask, F func) {
+    for (uint32_t bit = 0; bit < 64; bit++) {
+        if ((mask.Mask >> bit) & 1) {
+            func((uint32_t)mask.Group * 64 + bit);
+        }
+    }
+}
+#else
+/**
+ * readFirstNumber
+ *
+ * Reads the first unsigned number in a sysfs file.
+ *
+ * Return Value: Returns false if the file doesn't exist or doesn't start 
+ *               with a number.
+ */
+static bool readFirstNumber(const char *path, uint32_t *number) {
+    FILE *file = std::fopen(path, "r");
+    if (file == nullptr)
+        return false;
+    bool ok = std::fscanf(file, "%u", number) == 1;
+    std::fclose(file);
+    return ok;
+}
+#endif
+
+
+
+/**
+ * discoverCpus
+ *
+ * Return Value: Returns the CPUs the process may run on, sorted by node, 
+ *               then cluster, then number, so CPUs that share a cache or a
+ *               memory controller are next to each other. Empty if the 
+ *               topology can't be read.
+ */
+std::vector<CpuPlace> WinpoolNS::discoverCpus() {
+
+    std::vector<CpuPlace> places;
+
+#ifdef _WIN32
+    DWORD size = 0;
+    GetLogicalProcessorInformationEx(RelationAll, nullptr, &size);
+    if (GetLastError() != ERROR_INSUFFICIENT_BUFFER)
+        return places;
+    UniquePtr<char[]> buffer(new char[size]);
+    if (!GetLogicalProcessorInformationEx(
+            RelationAll, 
+            (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)buffer.get(), 
+            &size)) {
+        return places;
+    }
+
+    // The records come in no particular order: find the CPUs first, then
+    // fill in their nodes and caches
+    for (int pass = 0; pass < 2; pass++) {
+        for (DWORD offset = 0; offset < size; ) {
+            PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX info = 
+                (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)
+                    (buffer.get() + offset);
+            offset += info->Size;
+
+            if (pass == 0 && info->Relationship == RelationProcessorCore) {
+                for (WORD iGroup = 0; 
+                     iGroup < info->Processor.GroupCount; 
+                     iGroup++) {
+                    forEachCpu(
+                        info->Processor.GroupMask[iGroup], 
+                        [&places](uint32_t cpu) {
+                            places.push_back(CpuPlace{cpu, 0, cpu});
+                        }
+                    );
+                }
+            }
+            else if (pass == 1 && info->Relationship == RelationNumaNode) {
+                uint32_t node = info->NumaNode.NodeNumber;
+                forEachCpu(
+                    info->NumaNode.GroupMask, 
+                    [&places, node](uint32_t cpu) {
+                        for (CpuPlace &place : places) {
+                            if (place.cpu == cpu)
+                                place.node = node;
+                        }
+                    }
+                );
+            }
+            else if (pass == 1 && 
+                     info->Relationship == RelationCache && 
+                     info->Cache.Level == 3) {
+                uint32_t cluster = UINT32_MAX;
+                forEachCpu(info->Cache.GroupMask, [&cluster](uint32_t cpu) {
+                    cluster = std::min(cluster, cpu);
+                });
+                forEachCpu(
+                    info->Cache.GroupMask, 
+                    [&places, cluster](uint32_t cpu) {
+                        for (CpuPlace &place : places) {
+                            if (place.cpu == cpu)
+                                place.cluster = cluster;
+                        }
+                    }
+                );
+            }
+        }
+    }
+#else
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+        return places;
+
+    for (uint32_t cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+        if (!CPU_ISSET(cpu, &allowed))
+            continue;
+
+        // Without cache info every CPU is its own cluster
+        CpuPlace place = {cpu, 0, cpu};
+        char path[128];
+
+        // The CPU's sysfs directory links to its node as node<N>
+        std::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u", cpu);
+        DIR *dir = opendir(path);
+        if (dir != nullptr) {
+            struct dirent *entry;
+            while ((entry = readdir(dir)) != nullptr) {
+                if (std::sscanf(entry->d_name, "node%u", &place.node) == 1)
+                    break;
+            }
+            closedir(dir);
+        }
+
+        // CPUs sharing the last level cache list the same CPUs, so the 
+        // first of them names the cluster
+        for (int iCache = 3; iCache >= 2; iCache--) {
+            std::snprintf(
+                path, 
+                sizeof(path), 
+                "/sys/devices/system/cpu/cpu%u/cache/index%d/shared_cpu_list",
+                cpu,
+                iCache
+            );
+            if (readFirstNumber(path, &place.cluster))
+                break;
+        }
+
+        places.push_back(place);
+    }
+#endif
+
+    std::sort(
+        places.begin(), 
+        places.end(), 
+        [](const CpuPlace &a, const CpuPlace &b) {
+            if (a.node != b.node)
+                return a.node < b.node;
+            if (a.cluster != b.cluster)
+                return a.cluster < b.cluster;
+            return a.cpu < b.cpu;
+        }
+    );
+
+    return places;
+}
@@ -0,0 +1,132 @@
+
+/**
+ * executeFuture.cxx
+ */
+
+
+
+#include <memory>
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * skipTask
+ * 
+ * Should the task be skipped rather than run? Only cancellable tasks ever
+ * are: once cancelled, when their token is, or when their pool shuts 
+ * down in SHUTDOWN_FAST mode.
+ */
+static bool skipTask(Future *bFut, uint32_t prevStatus) {
+
+    if (prevStatus == CANCELLED)
+        return true;
+    if (!bFut->cancellable)
+        return false;
+
+    if (bFut->token != nullptr && 
+            bFut->token->cancelled.load(std::memory_order_relaxed)) {
+        return true;
+    }
+    // Futures built outside a pool (in tests) have no bPool
+    return bFut->bPool != nullptr && 
+           bFut->bPool->aborting.load(std::memory_order_relaxed);
+}
+
+
+
+/**
+ * executeFuture
+ * 
+ * Runs a Future's task on the calling worker thread and completes it: marks
+ * it RUNNING, runs its task (which stores the result), marks it DONE, 
+ * submits its continuations, wakes up any threads waiting for it and drops
+ * the pool's reference to it. 
+ * A cancellable task may be skipped rather than run (see skipTask), and 
+ * one that throws TaskCancelled gives up; either way the Future completes
+ * as cancelled.
+ * Detached Futures are deleted instead.
+ * 
+ * fut: Future that was just taken out of a queue, with ownership passed to 
+ *      this function.
+ * executor: Borrowed pointer to the calling thread's Worker.
+ */
+void WinpoolNS::executeFuture(UniquePtr<Future> fut, Worker *executor) {
+
+    Future *bFut = fut.get();
+
+    bFut->executor = executor;
+    uint32_t prevStatus = bFut->status.exchange(
+        RUNNING, 
+        std::memory_order_acq_rel
+    );
+
+    // Whatever the task submits (and its continuations) runs under its 
+    // token. We may be running inside another task's join: put that one's
+    // token back when done.
+    CancelState *bPrevToken = executor->bToken;
+    executor->bToken = bFut->token;
+
+    bool skip = skipTask(bFut, prevStatus);
+
+    // Execute the task. This also releases whatever its callable captured and
+    // sets res. Skipping it just releases the callable.
+    if (!skip) {
+        bumpCounter(&executor->nTasks, (uint64_t)1);
+        try {
+            bFut->invokeTask(bFut);
+        }
+        catch (TaskCancelled &) {
+            if (!bFut->cancellable) {
+                throw;
+            }
+            skip = true;
+        }
+    }
+    if (skip) {
+        bumpCounter(&executor->nCancelled, (uint64_t)1);
+        if (bFut->destroyTask != nullptr) {
+            bFut->destroyTask(bFut);
+            bFut->destroyTask = nullptr;
+        }
+        bFut->res = nullptr;
+        bFut->cancelled = true;
+    }
+
+    // Nobody will get a detached Future: just let it go
+    if (bFut->detached) {
+        executor->bToken = bPrevToken;
+        return;
+    }
+
+    // Publish the result and wake up any threads waiting for it. fut is the
+    // pool's reference: it keeps the Future alive until we're done touching
+    // it, then it's dropped like any other.
+    fut.release();
+    bFut->status.store(DONE, std::memory_order_release);
+
+    // Close the continuation list and submit whatever was waiting on it
+    Future *bCont = bFut->continuations.exchange(
+        bFut, 
+        std::memory_order_acq_rel
+    );
+    while (bCont != nullptr) {
+        Future *bNext = bCont->queueNext.load(std::memory_order_relaxed);
+        bCont->bPool->submitFuture(UniquePtr<Future>(bCont));
+        bCont = bNext;
+    }
+    executor->bToken = bPrevToken;
+
+    // Order the DONE store before the nWaiters check, pairs with the 
+    // seq_cst increment in externalGet
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (bFut->nWaiters.load(std::memory_order_relaxed) != 0) {
+        wakeAddressAll(&bFut->status);
+    }
+
+    bFut->release();
+}
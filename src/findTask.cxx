@@ -0,0 +1,47 @@
+/**
+ * findTask.cxx
+ */
+
+
+
+#include <memory>
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * findTask
+ * 
+ * Looks for a task for a worker to execute: first in its own deque, then in 
+ * the pool's queue, then in the other workers' deques.
+ * 
+ * pool: Borrowed pointer to the pool.
+ * myWorker: Borrowed pointer to the calling thread's Worker.
+ * 
+ * Return Value: Returns the task that was found with ownership passed to 
+ *               the caller, nullptr if there was none.
+ */
+UniquePtr<Future> WinpoolNS::findTask(Winpool *pool, Worker *myWorker) {
+
+    // Check our own deque first: the newest task is hottest in cache
+    UniquePtr<Future> fut = myWorker->taskQueue.pop();
+
+    // Check pool queue for tasks
+    if (fut == nullptr) {
+        fut = pool->taskQueue.pop(myWorker->nextRandom());
+        if (fut != nullptr) {
+            bumpCounter(&myWorker->nQueuePops, (uint64_t)1);
+        }
+    }
+
+    // Steal from the other workers' deques
+    if (fut == nullptr) {
+        fut = stealTask(pool, myWorker);
+    }
+
+    return fut;
+}
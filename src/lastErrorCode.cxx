@@ -0,0 +1,31 @@
+
+/**
+ * lastErrorCode.cxx
+ */
+
+
+
+#ifndef _WIN32
+#include <cerrno>
+#endif
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * lastErrorCode
+ *
+ * Return Value: Returns the error code of the last failed syscall made by the
+ *               calling thread.
+ */
+ErrorCode WinpoolNS::lastErrorCode() {
+#ifdef _WIN32
+    return GetLastError();
+#else
+    return errno;
+#endif
+}
@@ -0,0 +1,43 @@
+
+/**
+ * monotonicNs.cxx
+ */
+
+
+
+#ifndef _WIN32
+#include <ctime>
+#endif
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * monotonicNs
+ *
+ * Return Value: Returns the time in nanoseconds since some fixed point in 
+ *               the past. Never goes backwards; cheap enough to call from 
+ *               the scheduling hot path.
+ */
+uint64_t WinpoolNS::monotonicNs() {
+#ifdef _WIN32
+    static LARGE_INTEGER freq = []() {
+        LARGE_INTEGER f;
+        QueryPerformanceFrequency(&f);
+        return f;
+    }();
+    LARGE_INTEGER now;
+    QueryPerformanceCounter(&now);
+    return (uint64_t)(now.QuadPart / freq.QuadPart) * 1000000000ULL
+         + (uint64_t)(now.QuadPart % freq.QuadPart) * 1000000000ULL 
+           / (uint64_t)freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+#endif
+}
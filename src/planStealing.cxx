@@ -0,0 +1,58 @@
+/**
+ * planStealing.cxx
+ */
+
+
+
+#include <memory>
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * planStealing
+ * 
+ * Fills in every worker's stealOrder, nSameCluster and nSameNode from 
+ * their places.
+ * 
+ * workers: The pool's workers, with place set.
+ * nWorkers: Number of workers.
+ */
+void WinpoolNS::planStealing(Worker *workers, int nWorkers) {
+
+    for (int iWorker = 0; iWorker < nWorkers; iWorker++) {
+
+        Worker *worker = &workers[iWorker];
+        int *stealOrder = new int[nWorkers > 1 ? nWorkers - 1 : 1];
+        int nOrdered = 0;
+
+        // Three passes over the others: same cluster, same node, the rest
+        for (int iTier = 0; iTier < 3; iTier++) {
+            for (int iVictim = 0; iVictim < nWorkers; iVictim++) {
+                if (iVictim == iWorker)
+                    continue;
+
+                CpuPlace *victimPlace = &workers[iVictim].place;
+                bool sameNode = victimPlace->node == worker->place.node;
+                bool sameCluster = 
+                    sameNode && victimPlace->cluster == worker->place.cluster;
+                int victimTier = sameCluster ? 0 : (sameNode ? 1 : 2);
+
+                if (victimTier == iTier) {
+                    stealOrder[nOrdered++] = iVictim;
+                }
+            }
+
+            if (iTier == 0)
+                worker->nSameCluster = nOrdered;
+            else if (iTier == 1)
+                worker->nSameNode = nOrdered;
+        }
+
+        worker->stealOrder.reset(stealOrder);
+    }
+}
@@ -0,0 +1,34 @@
+
+/**
+ * sleepMs.cxx
+ */
+
+
+
+#ifndef _WIN32
+#include <ctime>
+#include <cerrno>
+#endif
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * sleepMs
+ *
+ * Suspends the calling thread for at least ms milliseconds.
+ */
+void WinpoolNS::sleepMs(uint32_t ms) {
+#ifdef _WIN32
+    Sleep(ms);
+#else
+    struct timespec ts;
+    ts.tv_sec = ms / 1000;
+    ts.tv_nsec = (long)(ms % 1000) * 1000000L;
+    while (nanosleep(&ts, &ts) != 0 && errno == EINTR) { }
+#endif
+}
@@ -0,0 +1,125 @@
+/**
+ * stealTask.cxx
+ */
+
+
+
+#include <memory>
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * stealFromTier
+ * 
+ * Tries to steal from the nVictims workers listed in victims, skipping 
+ * slots at or above nStarted: random probes, power of two choices on the 
+ * deque sizes, then a sweep of every one of them.
+ */
+static UniquePtr<Future> stealFromTier(Worker *workers, 
+                                       int nStarted,
+                                       const int *victims, 
+                                       int nVictims, 
+                                       Worker *myWorker) {
+
+    UniquePtr<Future> fut;
+    uint64_t nAttempts = 0;
+
+    for (int iProbe = 0; iProbe < nVictims && fut == nullptr; iProbe++) {
+
+        int iVictim1 = victims[myWorker->nextRandom() % nVictims];
+        int iVictim2 = victims[myWorker->nextRandom() % nVictims];
+        if (iVictim1 >= nStarted || iVictim2 >= nStarted)
+            continue;
+
+        FutureDeque *victim1Queue = &workers[iVictim1].taskQueue;
+        FutureDeque *victim2Queue = &workers[iVictim2].taskQueue;
+
+        int64_t victim1Size = victim1Queue->size();
+        int64_t victim2Size = victim2Queue->size();
+        if (victim1Size == 0 && victim2Size == 0)
+            continue;
+
+        nAttempts++;
+        fut = victim1Size >= victim2Size 
+              ? victim1Queue->steal()
+              : victim2Queue->steal();
+    }
+
+    // Sweep every deque once, starting at a random one
+    int iStart = (int)(myWorker->nextRandom() % nVictims);
+    for (int i = 0; i < nVictims && fut == nullptr; i++) {
+        int iVictim = victims[(iStart + i) % nVictims];
+        if (iVictim < nStarted && !workers[iVictim].taskQueue.empty()) {
+            nAttempts++;
+            fut = workers[iVictim].taskQueue.steal();
+        }
+    }
+
+    // Our own counters: no read-modify-write
+    bumpCounter(&myWorker->nStealAttempts, nAttempts);
+    if (fut != nullptr) {
+        bumpCounter(&myWorker->nSteals, (uint64_t)1);
+    }
+
+    return fut;
+}
+
+
+
+/**
+ * stealTask
+ * 
+ * Tries to steal a task from another worker's deque, nearest workers 
+ * first: the ones sharing our cluster's cache, then the rest of our NUMA 
+ * node, then remote ones, so subtasks stay close to the memory their 
+ * parents touched. Within each tier victims are picked at random so 
+ * thieves don't all line up on the same deques, and of every two random 
+ * candidates the one with the longer deque is tried. If that doesn't find
+ * anything, every deque in the tier is checked once, starting at a random 
+ * one, so a worker never goes to sleep while there is something to steal.
+ * 
+ * pool: Borrowed pointer to the pool.
+ * myWorker: Borrowed pointer to the calling thread's Worker.
+ * 
+ * Return Value: Returns the stolen task with ownership passed to the caller,
+ *               nullptr if there was none.
+ */
+UniquePtr<Future> WinpoolNS::stealTask(Winpool *pool, Worker *myWorker) {
+
+    Worker *workers = pool->workers.get();
+    const int *stealOrder = myWorker->stealOrder.get();
+
+    // Slots that never had a thread have nothing to steal
+    int nStarted = pool->nStarted.load(std::memory_order_acquire);
+
+    // Tiers of stealOrder: [0, nSameCluster), [nSameCluster, nSameNode),
+    // [nSameNode, nWorkers - 1)
+    int tierEnds[3] = {
+        myWorker->nSameCluster, 
+        myWorker->nSameNode, 
+        pool->nWorkers - 1
+    };
+
+    UniquePtr<Future> fut;
+    int tierStart = 0;
+    for (int iTier = 0; iTier < 3 && fut == nullptr; iTier++) {
+        int nVictims = tierEnds[iTier] - tierStart;
+        if (nVictims > 0) {
+            fut = stealFromTier(
+                workers, 
+                nStarted,
+                stealOrder + tierStart, 
+                nVictims, 
+                myWorker
+            );
+        }
+        tierStart = tierEnds[iTier];
+    }
+
+    return fut;
+}
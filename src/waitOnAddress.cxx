@@ -0,0 +1,47 @@
+
+/**
+ * waitOnAddress.cxx
+ */
+
+
+
+#ifndef _WIN32
+#include <climits>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#endif
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * waitOnAddress
+ *
+ * Blocks the calling thread while *addr == expected. Returns when another
+ * thread calls wakeAddressOne/wakeAddressAll on addr, or spuriously. Callers
+ * must re-check the condition they are waiting on.
+ *
+ * addr: Address of the word to wait on.
+ * expected: The value *addr must still hold for the thread to go to sleep.
+ */
+void WinpoolNS::waitOnAddress(std::atomic<uint32_t> *addr, uint32_t expected) {
+#ifdef _WIN32
+    WaitOnAddress(addr, &expected, sizeof(expected), INFINITE);
+#else
+    // EAGAIN (value changed) and EINTR are both just early returns here
+    syscall(
+        SYS_futex, 
+        (uint32_t *)addr, 
+        FUTEX_WAIT_PRIVATE, 
+        expected, 
+        nullptr, 
+        nullptr, 
+        0
+    );
+#endif
+}
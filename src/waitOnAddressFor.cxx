@@ -0,0 +1,58 @@
+/**
+ * waitOnAddressFor.cxx
+ */
+
+
+
+#ifndef _WIN32
+#include <ctime>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#endif
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * waitOnAddressFor
+ *
+ * Like waitOnAddress, but also returns once timeoutNs nanoseconds have 
+ * passed.
+ *
+ * addr: Address of the word to wait on.
+ * expected: The value *addr must still hold for the thread to go to sleep.
+ * timeoutNs: Longest time to sleep for.
+ */
+void WinpoolNS::waitOnAddressFor(std::atomic<uint32_t> *addr, 
+                                 uint32_t expected, 
+                                 uint64_t timeoutNs) {
+#ifdef _WIN32
+    // Round up so we never wake before the deadline, and stay below 
+    // INFINITE
+    uint64_t timeoutMs = (timeoutNs + 999999) / 1000000;
+    if (timeoutMs >= INFINITE) {
+        timeoutMs = INFINITE - 1;
+    }
+    WaitOnAddress(addr, &expected, sizeof(expected), (DWORD)timeoutMs);
+#else
+    // FUTEX_WAIT takes a relative timeout; ETIMEDOUT, EAGAIN and EINTR are 
+    // all just early returns here
+    struct timespec timeout;
+    timeout.tv_sec = (time_t)(timeoutNs / 1000000000ULL);
+    timeout.tv_nsec = (long)(timeoutNs % 1000000000ULL);
+    syscall(
+        SYS_futex, 
+        (uint32_t *)addr, 
+        FUTEX_WAIT_PRIVATE, 
+        expected, 
+        &timeout, 
+        nullptr, 
+        0
+    );
+#endif
+}
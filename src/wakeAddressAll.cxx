@@ -0,0 +1,41 @@
+
+/**
+ * wakeAddressAll.cxx
+ */
+
+
+
+#ifndef _WIN32
+#include <climits>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#endif
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * wakeAddressAll
+ *
+ * Wakes up every thread blocked in waitOnAddress on addr.
+ */
+void WinpoolNS::wakeAddressAll(std::atomic<uint32_t> *addr) {
+#ifdef _WIN32
+    WakeByAddressAll(addr);
+#else
+    syscall(
+        SYS_futex, 
+        (uint32_t *)addr, 
+        FUTEX_WAKE_PRIVATE, 
+        INT_MAX, 
+        nullptr, 
+        nullptr, 
+        0
+    );
+#endif
+}
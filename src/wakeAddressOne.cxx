@@ -0,0 +1,41 @@
+
+/**
+ * wakeAddressOne.cxx
+ */
+
+
+
+#ifndef _WIN32
+#include <climits>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#endif
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * wakeAddressOne
+ *
+ * Wakes up at most one thread blocked in waitOnAddress on addr.
+ */
+void WinpoolNS::wakeAddressOne(std::atomic<uint32_t> *addr) {
+#ifdef _WIN32
+    WakeByAddressSingle(addr);
+#else
+    syscall(
+        SYS_futex, 
+        (uint32_t *)addr, 
+        FUTEX_WAKE_PRIVATE, 
+        1, 
+        nullptr, 
+        nullptr, 
+        0
+    );
+#endif
+}
@@ -6,7 +6,6 @@
 
 
 #include <cstdio>
-#include <windows.h>
 #include <memory>
 #include "_winpool_private.hxx"
 
@@ -16,96 +15,214 @@ using namespace WinpoolNS;
 
 
 
+/**
+ * enterIdle
+ * 
+ * Counts the calling worker in nIdle before it goes to sleep, waking up 
+ * shutdown if it's the last one. Returns the time, for leaveIdle.
+ */
+static uint64_t enterIdle(Winpool *pool, Worker *myWorker) {
+
+    bumpCounter(&myWorker->nSleeps, (uint64_t)1);
+
+    uint32_t nIdle = pool->nIdle.fetch_add(1, std::memory_order_seq_cst) + 1;
+    if (pool->shutDown.load(std::memory_order_seq_cst) && 
+            nIdle == (uint32_t)pool->nStarted.load(std::memory_order_relaxed)) {
+        wakeAddressAll(&pool->nIdle);
+    }
+
+    return monotonicNs();
+}
+
+
+
+/**
+ * leaveIdle
+ * 
+ * Takes the calling worker back out of nIdle after it woke up, adding the
+ * time since sinceNs to its sleepNs or parkedNs counter.
+ */
+static void leaveIdle(Winpool *pool, 
+                      std::atomic<uint64_t> *timeCounter, 
+                      uint64_t sinceNs) {
+    pool->nIdle.fetch_sub(1, std::memory_order_seq_cst);
+    bumpCounter(timeCounter, monotonicNs() - sinceNs);
+}
+
+
+
+/**
+ * parkWorker
+ * 
+ * Retires the calling worker until Winpool::adjustWorkers needs it again
+ * (or the pool shuts down).
+ */
+static void parkWorker(Winpool *pool, Worker *myWorker, int iMyWorker) {
+
+    // We may have been woken up for a task we're not going to run: pass 
+    // the wakeup on
+    pool->idleWorkers.notifyOne();
+
+    // seq_cst: see adjustWorkers
+    myWorker->state.store(WORKER_PARKED, std::memory_order_seq_cst);
+    if (iMyWorker < pool->activeTarget() || 
+            !pool->running.load(std::memory_order_seq_cst)) {
+        // Needed again already. If adjustWorkers got there first, it has 
+        // set us back to active itself.
+        uint32_t parked = WORKER_PARKED;
+        myWorker->state.compare_exchange_strong(
+            parked, 
+            WORKER_ACTIVE, 
+            std::memory_order_seq_cst
+        );
+        return;
+    }
+
+    uint64_t sinceNs = enterIdle(pool, myWorker);
+    while (myWorker->state.load(std::memory_order_acquire) == WORKER_PARKED) {
+        waitOnAddress(&myWorker->state, WORKER_PARKED);
+    }
+    leaveIdle(pool, &myWorker->parkedNs, sinceNs);
+}
+
+
+
+/**
+ * idleWait
+ * 
+ * Puts an idle worker to sleep on the pool's idleWorkers after it 
+ * registered with prepareWait (key) and found nothing to do. If timers are
+ * armed and no other idle worker wakes up in time for the next one, this 
+ * worker keeps time: it sleeps only until then.
+ */
+static void idleWait(Winpool *pool, Worker *myWorker, uint32_t key) {
+
+    TimerWheel *wheel = &pool->timers;
+    uint64_t dueNs = wheel->dueNs.load(std::memory_order_seq_cst);
+    uint64_t keeperNs = wheel->keeperWakeNs.load(std::memory_order_seq_cst);
+
+    bool keepTime = false;
+    while (!keepTime && dueNs != UINT64_MAX && dueNs < keeperNs) {
+        keepTime = wheel->keeperWakeNs.compare_exchange_weak(
+            keeperNs, 
+            dueNs, 
+            std::memory_order_seq_cst
+        );
+    }
+    if (!keepTime) {
+        uint64_t sinceNs = enterIdle(pool, myWorker);
+        pool->idleWorkers.wait(key);
+        leaveIdle(pool, &myWorker->sleepNs, sinceNs);
+        return;
+    }
+
+    uint64_t nowNs = enterIdle(pool, myWorker);
+    pool->idleWorkers.waitFor(key, dueNs > nowNs ? dueNs - nowNs : 0);
+    leaveIdle(pool, &myWorker->sleepNs, nowNs);
+
+    // Woken up early (for a task): hand timekeeping over to another idle 
+    // worker, if there is one
+    uint64_t ourNs = dueNs;
+    if (wheel->keeperWakeNs.compare_exchange_strong(
+                ourNs, 
+                UINT64_MAX, 
+                std::memory_order_seq_cst) && 
+            monotonicNs() < dueNs) {
+        pool->idleWorkers.notifyOne();
+    }
+}
+
+
+
 /**
  * workerTProc
  * 
  * Base function run by the worker thread processes.
  * Loops, searching for tasks in the pool's queue and the other workers' 
  * queues and executing them until the pool shuts down.
+ * When there is nothing to do, a worker keeps searching for a while, then 
+ * yields, then goes to sleep on the pool's idleWorkers until a task is
+ * submitted (or, for one of them, until the next timer is due). Workers 
+ * in slots at or above the pool's activeTarget park instead, once their 
+ * own deque is empty.
  * 
  * arg: Borrowed pointer to a WorkerTProcData instance that contains data about
  *      the pool and about the running thread.
- * 
- * Return Value: Doesn't matter
  */
-DWORD WINAPI WinpoolNS::workerTProc(void *arg) {
-
-    BOOL boolRc;
+void WinpoolNS::workerTProc(void *arg) {
 
     WorkerTProcData *workerData = (WorkerTProcData *)arg;
     Worker *myWorker = workerData->myWorker;
-    DWORD tlsMyWorkerIndex = workerData->tlsMyWorkerIdx;
+    TlsSlot *workerTls = workerData->workerTls;
     Winpool *pool = workerData->pool;
 
-    Worker *workers = pool->workers.get();
-    int nWorkers = pool->nWorkers;
-
     // Set the my worker Tls variable
-    boolRc = TlsSetValue(tlsMyWorkerIndex, myWorker);
-    if (!boolRc) {
-        EnterCriticalSection(pool->lock);
-        std::fprintf(stderr, "workerTProc TlsSetValue failed\n");
+    try {
+        workerTls->set(myWorker);
+    }
+    catch (SyscallError e) {
+        pool->lock->enter();
+        std::fprintf(stderr, "workerTProc TlsSlot::set failed\n");
         std::fflush(stderr);
-        LeaveCriticalSection(pool->lock);
-        return -1;
+        pool->lock->leave();
+        return;
     }
 
-    EnterCriticalSection(pool->lock);
-    while (pool->running) {
+    // Futures created on this thread come from our worker's slab
+    FutureSlab::tlsMySlab = myWorker->slab;
 
-        UniquePtr<Future> futToExec = nullptr;
+    int iMyWorker = (int)(myWorker - pool->workers.get());
+    int nIdleRounds = 0;
+    while (pool->running.load(std::memory_order_acquire)) {
 
-        // Check pool queue for tasks
-        if (!pool->futures.taskQueue.empty()) {
-            futToExec = pool->futures.taskQueue.popHead();
-            futToExec->status = RUNNING;
-            futToExec->executor = myWorker;
-        }
-        LeaveCriticalSection(pool->lock);
-
-        // Check all worker queues for tasks
-        for (int iWorker = 0; 
-             iWorker < nWorkers && futToExec == nullptr; 
-             iWorker++) {
-
-            Worker *currWorker = &workers[iWorker];
-            EnterCriticalSection(&currWorker->lock);
-            if (!currWorker->taskQueue.empty()) {
-                futToExec = currWorker->taskQueue.popTail();
-                futToExec->status = RUNNING;
-                futToExec->executor = myWorker;
+        // More workers than needed: finish what's on our own deque, then 
+        // retire
+        if (iMyWorker >= pool->activeTarget()) {
+            UniquePtr<Future> ownFut = myWorker->taskQueue.pop();
+            if (ownFut != nullptr) {
+                executeFuture(std::move(ownFut), myWorker);
+            }
+            else {
+                parkWorker(pool, myWorker, iMyWorker);
             }
-            LeaveCriticalSection(&currWorker->lock);
+            nIdleRounds = 0;
+            continue;
         }
 
-        // We found a future - execute it
-        if (futToExec != nullptr) {
-            
-            // Execute the task
-            void *futRes = futToExec->func(futToExec->arg);
-
-            Future *bFutToExec = futToExec.get();
-            
-            // Save the result, add futToExec to its completed list and wake 
-            // up any threads waiting for the result
-            EnterCriticalSection(futToExec->lock);
-            futToExec->status = DONE;
-            futToExec->res = futRes;
-            futToExec->owner->completedList.insertTail(std::move(futToExec));
-            WakeAllConditionVariable(&bFutToExec->condCompleted);
-            LeaveCriticalSection(bFutToExec->lock);
-        }
+        pool->runTimers();
+
+        UniquePtr<Future> futToExec = findTask(pool, myWorker);
 
-        // Sleep for a little before checking again
-        else {
-            Sleep(1); // 1 ms
+        // Spin, then yield, then sleep until somebody submits a task
+        if (futToExec == nullptr) {
+            if (nIdleRounds < idleSpinRounds) {
+                nIdleRounds++;
+                continue;
+            }
+            if (nIdleRounds < idleSpinRounds + idleYieldRounds) {
+                nIdleRounds++;
+                bumpCounter(&myWorker->nYields, (uint64_t)1);
+                yieldThread();
+                continue;
+            }
+
+            uint32_t key = pool->idleWorkers.prepareWait();
+            futToExec = findTask(pool, myWorker);
+            if (futToExec == nullptr) {
+                if (pool->running.load())
+                    idleWait(pool, myWorker, key);
+                else
+                    pool->idleWorkers.cancelWait();
+                nIdleRounds = 0;
+                continue;
+            }
+            pool->idleWorkers.cancelWait();
         }
 
-        // pool->lock must be held here
-        EnterCriticalSection(pool->lock);
+        // We found a future - execute it
+        nIdleRounds = 0;
+        executeFuture(std::move(futToExec), myWorker);
     }
 
-    LeaveCriticalSection(pool->lock);
-
-    return 0;
+    FutureSlab::tlsMySlab = nullptr;
 }
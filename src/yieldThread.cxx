@@ -0,0 +1,30 @@
+
+/**
+ * yieldThread.cxx
+ */
+
+
+
+#ifndef _WIN32
+#include <sched.h>
+#endif
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * yieldThread
+ *
+ * Gives up the rest of the calling thread's time slice.
+ */
+void WinpoolNS::yieldThread() {
+#ifdef _WIN32
+    Sleep(0);
+#else
+    sched_yield();
+#endif
+}
@@ -20,86 +20,49 @@ using namespace std::chrono;
 
 
 
-/**
- * SumArrArgs
- * 
- * Class that contains data passed to sumArr.
- */
-class SumArrArgs {
-public:
-
-    /* bPool: Borrowed pointer to the Winpool this task is running on. */
-    Winpool *bPool;
-
-    /* arr: Pointer to the integer array to sum from. */
-    int32_t *arr;
-
-    /* iStart: Start of the segment to sum (inclusive). */
-    size_t iStart; 
-
-    /* iEnd: End of the segment to sum (exclusive). */
-    size_t iEnd;
-
-    SumArrArgs(Winpool *bPool, int32_t *arr, size_t iStart, size_t iEnd);
-};
-
-
-/**
- * SumArrArgs constructor
- */
-SumArrArgs::SumArrArgs(Winpool *bPool, 
-                       int32_t *arr, 
-                       size_t iStart, 
-                       size_t iEnd) {
-
-    this->bPool = bPool;
-    this->arr = arr;
-    this->iStart = iStart;
-    this->iEnd = iEnd;
-}
-
-
-
 /**
  * sumArr
  * 
- * Winpool task that recursively finds the sum of an array.
+ * Winpool task that recursively finds the sum of a segment of an array.
+ * 
+ * bPool: Borrowed pointer to the Winpool this task is running on.
+ * arr: Pointer to the integer array to sum from.
+ * iStart: Start of the segment to sum (inclusive).
+ * iEnd: End of the segment to sum (exclusive).
+ * 
+ * Return Value: Returns the sum of the segment.
  */
-void *sumArr(void *_arg) {
-
-    UniquePtr<SumArrArgs> args = UniquePtr<SumArrArgs>(
-        (SumArrArgs *)_arg
-    );
+int64_t sumArr(Winpool *bPool, int32_t *arr, size_t iStart, size_t iEnd) {
 
     // Base case: Small segment
-    if (args->iEnd - args->iStart < 1000) {
+    if (iEnd - iStart < 1000) {
         int64_t sum = 0;
-        for (size_t i = args->iStart; i < args->iEnd; i++) {
-            sum += args->arr[i];
+        for (size_t i = iStart; i < iEnd; i++) {
+            sum += arr[i];
         }
-        return (void *)sum;
+        return sum;
     }
 
     // Find the midpoint
-    size_t iMid = (args->iStart + args->iEnd) / 2;
+    size_t iMid = (iStart + iEnd) / 2;
     
     // Submit the task to sum the second half
-    Future *bHalf2Fut = args->bPool->submit(
+    TypedFuture<int64_t> half2Fut = bPool->submit(
         sumArr, 
-        new SumArrArgs(args->bPool, args->arr, iMid, args->iEnd)
+        bPool, 
+        arr, 
+        iMid, 
+        iEnd
     );
 
     // Sum the first half
-    int64_t half1Sum = (int64_t)sumArr(
-        new SumArrArgs(args->bPool, args->arr, args->iStart, iMid)
-    );
+    int64_t half1Sum = sumArr(bPool, arr, iStart, iMid);
 
     // Join the second half Future
-    UniquePtr<Future> half2Fut;
-    int64_t half2Sum = (int64_t)bHalf2Fut->get(&half2Fut);
+    int64_t half2Sum = half2Fut.get();
 
     // Return the sum
-    return (void *)(half1Sum + half2Sum);
+    return half1Sum + half2Sum;
 }
 
 
@@ -144,14 +107,16 @@ int main() {
     TimePoint start = high_resolution_clock::now();
 
     // Submit/run the task
-    UniquePtr<Future> fut;
-    Future *bFut = pool->submit(
+    TypedFuture<int64_t> fut = pool->submit(
         sumArr, 
-        new SumArrArgs(pool.get(), arr, 0, len_arr)
+        pool.get(), 
+        arr, 
+        (size_t)0, 
+        len_arr
     );
 
     // Join the task and get the result
-    int64_t sum = (int64_t)bFut->get(&fut);
+    int64_t sum = fut.get();
 
     // Stop the stopwatch
     TimePoint end = high_resolution_clock::now();
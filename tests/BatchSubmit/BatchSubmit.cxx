@@ -0,0 +1,133 @@
+/**
+ * BatchSubmit.cxx
+ * 
+ * Compares submitting N tiny tasks one submit at a time with submitting 
+ * them all with a single submitBatch, from an external thread and from 
+ * inside a task.
+ */
+
+
+
+#include <memory>
+#include <atomic>
+#include <cstdio>
+#include <chrono>
+#include <winpool.hxx>
+
+
+
+using namespace WinpoolNS;
+using namespace std::chrono;
+
+
+
+/* N_ROUNDS: Number of batches submitted per measurement. */
+#define N_ROUNDS 200
+
+/* BATCH_SIZE: Number of tasks per batch. */
+#define BATCH_SIZE 1000
+
+
+
+/* nDone: Counts finished tasks so the work can't be optimized away. */
+static std::atomic<int64_t> nDone(0);
+
+
+
+/**
+ * runSingle
+ * 
+ * Submits N_ROUNDS batches of BATCH_SIZE tasks one submit call at a time,
+ * joining each batch.
+ */
+static void runSingle(Winpool *bPool) {
+
+    UniquePtr<TypedFuture<void>[]> futs(new TypedFuture<void>[BATCH_SIZE]);
+
+    for (int iRound = 0; iRound < N_ROUNDS; iRound++) {
+        for (int i = 0; i < BATCH_SIZE; i++) {
+            futs[i] = bPool->submit([]() {
+                nDone.fetch_add(1, std::memory_order_relaxed);
+            });
+        }
+        for (int i = 0; i < BATCH_SIZE; i++) {
+            futs[i].get();
+        }
+    }
+}
+
+
+
+/**
+ * runBatch
+ * 
+ * Submits N_ROUNDS batches of BATCH_SIZE tasks with submitBatch, joining
+ * each batch.
+ */
+static void runBatch(Winpool *bPool) {
+
+    for (int iRound = 0; iRound < N_ROUNDS; iRound++) {
+        TaskBatch batch = bPool->submitBatch(BATCH_SIZE, [](uint32_t i) {
+            nDone.fetch_add(1, std::memory_order_relaxed);
+        });
+        batch.join();
+    }
+}
+
+
+
+/**
+ * measure
+ * 
+ * Times run(bPool), either on the calling thread or inside a task, and 
+ * prints the task throughput.
+ */
+static void measure(const char *name, 
+                    Winpool *bPool, 
+                    void (*run)(Winpool *), 
+                    bool fromWorker) {
+
+    steady_clock::time_point start = steady_clock::now();
+    if (fromWorker) {
+        bPool->submit(run, bPool).get();
+    }
+    else {
+        run(bPool);
+    }
+    steady_clock::time_point end = steady_clock::now();
+
+    double secs = duration_cast<nanoseconds>(end - start).count() / 1e9;
+    std::printf(
+        "%-24s %12.0lf tasks/s\n", 
+        name, 
+        (double)N_ROUNDS * BATCH_SIZE / secs
+    );
+    std::fflush(stdout);
+}
+
+
+
+/**
+ * main
+ * 
+ * Execution starts here.
+ */
+int main() {
+
+    UniquePtr<Winpool> pool;
+    try {
+        pool = Winpool::createNew(16);
+    }
+    catch (SyscallError e) {
+        std::fprintf(stderr, "syscall failure Winpool::createNew\n");
+        std::fflush(stderr);
+        return 1;
+    }
+
+    measure("external submit", pool.get(), runSingle, false);
+    measure("external submitBatch", pool.get(), runBatch, false);
+    measure("worker submit", pool.get(), runSingle, true);
+    measure("worker submitBatch", pool.get(), runBatch, true);
+
+    return 0;
+}
@@ -0,0 +1,134 @@
+/**
+ * BlockingTasks.cxx
+ *
+ * Runs tasks that spend most of their time blocked (sleeping, standing in
+ * for I/O), without and with announcing it through BlockingRegion, and
+ * checks that compensating workers keep the pool busy. Then grows and
+ * shrinks the pool with setWorkerCount and checks it follows.
+ */
+
+
+
+#include <memory>
+#include <atomic>
+#include <cstdio>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <winpool.hxx>
+
+
+
+using namespace WinpoolNS;
+using namespace std::chrono;
+
+
+
+/* N_BASE_WORKERS: Number of workers the pool is created with. */
+#define N_BASE_WORKERS 2
+
+/* N_MAX_WORKERS: Number of worker slots. */
+#define N_MAX_WORKERS 16
+
+/* N_TASKS: Number of blocking tasks per round. */
+#define N_TASKS 32
+
+/* BLOCK_MS: Time each task spends blocked. */
+#define BLOCK_MS 20
+
+
+
+/**
+ * runRound
+ *
+ * Submits N_TASKS tasks that block for BLOCK_MS each, inside a
+ * BlockingRegion or not, waits for them all and returns the elapsed time
+ * in milliseconds.
+ */
+static double runRound(Winpool *bPool, bool announce) {
+
+    steady_clock::time_point start = steady_clock::now();
+
+    bPool->submit([bPool, announce]() {
+        std::vector<TypedFuture<void>> futs;
+        for (int i = 0; i < N_TASKS; i++) {
+            futs.push_back(bPool->submit([bPool, announce]() {
+                if (announce) {
+                    BlockingRegion region(bPool);
+                    std::this_thread::sleep_for(milliseconds(BLOCK_MS));
+                }
+                else {
+                    std::this_thread::sleep_for(milliseconds(BLOCK_MS));
+                }
+            }));
+        }
+        for (TypedFuture<void> &fut : futs) {
+            fut.get();
+        }
+    }).get();
+
+    steady_clock::time_point end = steady_clock::now();
+    return duration_cast<microseconds>(end - start).count() / 1e3;
+}
+
+
+
+/**
+ * main
+ *
+ * Execution starts here.
+ */
+int main() {
+
+    UniquePtr<Winpool> pool;
+    try {
+        pool = Winpool::createNew(N_BASE_WORKERS, N_MAX_WORKERS);
+    }
+    catch (SyscallError e) {
+        std::fprintf(stderr, "syscall failure Winpool::createNew\n");
+        std::fflush(stderr);
+        return 1;
+    }
+
+    Winpool *bPool = pool.get();
+
+    double plainMs = runRound(bPool, false);
+    double announcedMs = runRound(bPool, true);
+    std::printf(
+        "%d workers, %d tasks blocking %d ms: plain %8.1lf ms, "
+            "announced %8.1lf ms\n",
+        N_BASE_WORKERS,
+        N_TASKS,
+        BLOCK_MS,
+        plainMs,
+        announcedMs
+    );
+    std::fflush(stdout);
+
+    // Blocked workers get replaced, so announced rounds overlap many more
+    // sleeps than there are base workers
+    if (announcedMs * 2 > plainMs) {
+        std::fprintf(stderr, "blocked workers weren't compensated for\n");
+        return 1;
+    }
+
+    // Resizing the pool itself
+    bPool->setWorkerCount(N_MAX_WORKERS);
+    double grownMs = runRound(bPool, false);
+    bPool->setWorkerCount(1);
+    double shrunkMs = runRound(bPool, false);
+    std::printf(
+        "%d workers: %8.1lf ms, 1 worker: %8.1lf ms\n",
+        N_MAX_WORKERS,
+        grownMs,
+        shrunkMs
+    );
+    std::fflush(stdout);
+
+    if (grownMs * 2 > plainMs || shrunkMs < plainMs) {
+        std::fprintf(stderr, "setWorkerCount didn't take effect\n");
+        return 1;
+    }
+
+    return 0;
+}
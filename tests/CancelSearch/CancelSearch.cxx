@@ -0,0 +1,196 @@
+/**
+ * CancelSearch.cxx
+ *
+ * Searches a tree of tasks for a leaf with a given property, once visiting
+ * every leaf (counting the matches) and once stopping at the first match by
+ * cancelling the whole tree through a CancelToken. Measures the wall and
+ * CPU time early termination saves.
+ */
+
+
+
+#include <memory>
+#include <atomic>
+#include <cstdio>
+#include <ctime>
+#include <chrono>
+#include <cstdint>
+#include <inttypes.h>
+#include <winpool.hxx>
+
+
+
+using namespace WinpoolNS;
+using namespace std::chrono;
+
+
+
+/* FANOUT: Number of children of every inner node. */
+#define FANOUT 8
+
+/* DEPTH: Number of levels of inner nodes above the leaves. */
+#define DEPTH 4
+
+/* LEAF_ITERS: Hashing steps it takes to examine a leaf. */
+#define LEAF_ITERS 20000
+
+/* POLL_INTERVAL: Hashing steps between cancellation checks in a leaf. */
+#define POLL_INTERVAL 1024
+
+/* MATCH_MASK: A leaf matches if these bits of its hash are all 0. */
+#define MATCH_MASK 63
+
+
+
+/**
+ * Search class
+ *
+ * State shared by every task of one search.
+ */
+class Search final {
+public:
+
+    /* bPool: Borrowed pointer to the pool running the search. */
+    Winpool *bPool;
+
+    /* token: Cancels the rest of the tree after the first match, if 
+              stopAtFirst. */
+    CancelToken token;
+
+    /* stopAtFirst: Stop at the first match rather than count them all? */
+    bool stopAtFirst;
+
+    /* nMatches: Number of matching leaves found. */
+    std::atomic<uint64_t> nMatches;
+
+    /* nLeaves: Number of leaves examined, fully or not. */
+    std::atomic<uint64_t> nLeaves;
+};
+
+
+
+/**
+ * searchNode
+ *
+ * Examines the subtree of node, depth levels above the leaves: an inner 
+ * node submits one task per child and joins them. Throws TaskCancelled if
+ * a child was cancelled.
+ */
+static void searchNode(Search *bSearch, uint64_t node, int depth) {
+
+    if (depth == 0) {
+        bSearch->nLeaves.fetch_add(1, std::memory_order_relaxed);
+
+        uint64_t h = node;
+        for (int i = 0; i < LEAF_ITERS; i++) {
+            if (i % POLL_INTERVAL == 0 && bSearch->bPool->cancelRequested())
+                return;
+            h += 0x9E3779B97F4A7C15ULL;
+            h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            h = (h ^ (h >> 27)) * 0x94D049BB133111EBULL;
+            h ^= h >> 31;
+        }
+
+        if ((h & MATCH_MASK) == 0) {
+            bSearch->nMatches.fetch_add(1, std::memory_order_relaxed);
+            if (bSearch->stopAtFirst) {
+                bSearch->token.cancel();
+            }
+        }
+        return;
+    }
+
+    // Children inherit the token of the task submitting them
+    TypedFuture<void> children[FANOUT];
+    for (int iChild = 0; iChild < FANOUT; iChild++) {
+        children[iChild] = bSearch->bPool->submit(
+            searchNode, 
+            bSearch, 
+            node * FANOUT + iChild, 
+            depth - 1
+        );
+    }
+    for (int iChild = 0; iChild < FANOUT; iChild++) {
+        children[iChild].get();
+    }
+}
+
+
+
+/**
+ * runSearch
+ *
+ * Searches the whole tree and prints how long it took, in wall and CPU 
+ * time. Returns the CPU time in milliseconds.
+ */
+static double runSearch(Winpool *bPool, bool stopAtFirst) {
+
+    Search search;
+    search.bPool = bPool;
+    search.stopAtFirst = stopAtFirst;
+    search.nMatches.store(0);
+    search.nLeaves.store(0);
+
+    steady_clock::time_point start = steady_clock::now();
+    std::clock_t cpuStart = std::clock();
+
+    bool cancelled = false;
+    try {
+        bPool->submit(search.token, searchNode, &search, 1, DEPTH).get();
+    }
+    catch (TaskCancelled &) {
+        cancelled = true;
+    }
+
+    std::clock_t cpuEnd = std::clock();
+    steady_clock::time_point end = steady_clock::now();
+
+    double wallMs = duration_cast<microseconds>(end - start).count() / 1e3;
+    double cpuMs = 
+        1000.0 * (double)(cpuEnd - cpuStart) / (double)CLOCKS_PER_SEC;
+    std::printf(
+        "%-15s %6" PRIu64 " leaves examined, %4" PRIu64 " matches, "
+            "%s: wall %8.1lf ms, CPU %8.1lf ms\n",
+        stopAtFirst ? "first match:" : "all matches:",
+        search.nLeaves.load(),
+        search.nMatches.load(),
+        cancelled ? "cancelled" : "completed",
+        wallMs,
+        cpuMs
+    );
+    std::fflush(stdout);
+
+    return cpuMs;
+}
+
+
+
+/**
+ * main
+ *
+ * Execution starts here.
+ */
+int main() {
+
+    UniquePtr<Winpool> pool;
+    try {
+        pool = Winpool::createNew(16);
+    }
+    catch (SyscallError e) {
+        std::fprintf(stderr, "syscall failure Winpool::createNew\n");
+        std::fflush(stderr);
+        return 1;
+    }
+
+    double fullCpuMs = runSearch(pool.get(), false);
+    double earlyCpuMs = runSearch(pool.get(), true);
+
+    // About one leaf in MATCH_MASK + 1 matches, so the first match comes 
+    // early and the rest of the tree should be skipped
+    if (earlyCpuMs * 2 > fullCpuMs) {
+        std::fprintf(stderr, "cancelling the search saved little CPU\n");
+        return 1;
+    }
+
+    return 0;
+}
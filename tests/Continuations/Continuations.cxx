@@ -0,0 +1,204 @@
+/**
+ * Continuations.cxx
+ * 
+ * Runs lots of three-stage request pipelines (one task, a fan-out of 
+ * parts, one task combining them), once with each stage calling get on 
+ * the next and once chained with then and whenAll so no thread waits, and
+ * compares the requests finished per second. Also checks whenAny.
+ */
+
+
+
+#include <memory>
+#include <vector>
+#include <cstdio>
+#include <chrono>
+#include <winpool.hxx>
+
+
+
+using namespace WinpoolNS;
+using namespace std::chrono;
+
+
+
+/* N_REQUESTS: Number of pipelines in flight at once. */
+#define N_REQUESTS 20000
+
+/* N_PARTS: Number of parts each request fans out into. */
+#define N_PARTS 4
+
+/* STAGE_WORK: Iterations of busy work in each stage. */
+#define STAGE_WORK 500
+
+
+
+/**
+ * busyWork
+ * 
+ * Stands in for what a stage actually computes.
+ */
+static int64_t busyWork(int64_t x) {
+    volatile int64_t acc = x;
+    for (int i = 0; i < STAGE_WORK; i++) {
+        acc = acc + 1;
+    }
+    return acc - STAGE_WORK;
+}
+
+
+
+static int64_t stage1(int64_t iRequest) {
+    return busyWork(iRequest * 3);
+}
+
+static int64_t stage2(int64_t a, int64_t iPart) {
+    return busyWork(a + iPart);
+}
+
+static int64_t stage3(int64_t sum) {
+    return busyWork(sum * 2);
+}
+
+/**
+ * expected
+ * 
+ * Return Value: Returns what request iRequest should come up with.
+ */
+static int64_t expected(int64_t iRequest) {
+    return 2 * (N_PARTS * 3 * iRequest + N_PARTS * (N_PARTS - 1) / 2);
+}
+
+
+
+/**
+ * requestBlocking
+ * 
+ * Winpool task running a whole request, waiting for each stage with get.
+ */
+static int64_t requestBlocking(Winpool *bPool, int64_t iRequest) {
+
+    int64_t a = bPool->submit(stage1, iRequest).get();
+
+    TypedFuture<int64_t> parts[N_PARTS];
+    for (int iPart = 0; iPart < N_PARTS; iPart++) {
+        parts[iPart] = bPool->submit(stage2, a, (int64_t)iPart);
+    }
+    int64_t sum = 0;
+    for (int iPart = 0; iPart < N_PARTS; iPart++) {
+        sum += parts[iPart].get();
+    }
+
+    return bPool->submit(stage3, sum).get();
+}
+
+
+
+/**
+ * requestChained
+ * 
+ * Starts a request whose stages are chained with then and whenAll.
+ * 
+ * Return Value: Returns a handle whose result is the handle of the last
+ *               stage.
+ */
+static TypedFuture<TypedFuture<int64_t>> requestChained(Winpool *bPool, 
+                                                        int64_t iRequest) {
+
+    return bPool->submit(stage1, iRequest).then([bPool](int64_t a) {
+
+        std::vector<TypedFuture<int64_t>> parts;
+        for (int iPart = 0; iPart < N_PARTS; iPart++) {
+            parts.push_back(bPool->submit(stage2, a, (int64_t)iPart));
+        }
+
+        return bPool->whenAll(std::move(parts)).then(
+            [](std::vector<TypedFuture<int64_t>> doneParts) {
+                int64_t sum = 0;
+                for (TypedFuture<int64_t> &part : doneParts) {
+                    sum += part.get();
+                }
+                return stage3(sum);
+            }
+        );
+    });
+}
+
+
+
+/**
+ * main
+ * 
+ * Execution starts here.
+ */
+int main() {
+
+    UniquePtr<Winpool> pool;
+    try {
+        pool = Winpool::createNew(16);
+    }
+    catch (SyscallError e) {
+        std::fprintf(stderr, "syscall failure Winpool::createNew\n");
+        std::fflush(stderr);
+        return 1;
+    }
+    Winpool *bPool = pool.get();
+
+    std::vector<TypedFuture<int64_t>> blockingReqs;
+    steady_clock::time_point start = steady_clock::now();
+    for (int64_t iRequest = 0; iRequest < N_REQUESTS; iRequest++) {
+        blockingReqs.push_back(
+            bPool->submit(requestBlocking, bPool, iRequest)
+        );
+    }
+    for (int64_t iRequest = 0; iRequest < N_REQUESTS; iRequest++) {
+        if (blockingReqs[iRequest].get() != expected(iRequest)) {
+            std::fprintf(stderr, "wrong blocking result %lld\n", 
+                         (long long)iRequest);
+            return 1;
+        }
+    }
+    steady_clock::time_point mid = steady_clock::now();
+
+    std::vector<TypedFuture<TypedFuture<int64_t>>> chainedReqs;
+    for (int64_t iRequest = 0; iRequest < N_REQUESTS; iRequest++) {
+        chainedReqs.push_back(requestChained(bPool, iRequest));
+    }
+    for (int64_t iRequest = 0; iRequest < N_REQUESTS; iRequest++) {
+        if (chainedReqs[iRequest].get().get() != expected(iRequest)) {
+            std::fprintf(stderr, "wrong chained result %lld\n", 
+                         (long long)iRequest);
+            return 1;
+        }
+    }
+    steady_clock::time_point end = steady_clock::now();
+
+    // whenAny hands back every task, one of them done
+    std::vector<TypedFuture<int64_t>> racers;
+    for (int iRacer = 0; iRacer < N_PARTS; iRacer++) {
+        racers.push_back(bPool->submit(stage2, (int64_t)0, (int64_t)iRacer));
+    }
+    WhenAnyResult<int64_t> first = bPool->whenAny(std::move(racers)).get();
+    if (first.index >= N_PARTS || 
+            first.futures[first.index].get() != (int64_t)first.index) {
+        std::fprintf(stderr, "whenAny returned a wrong index\n");
+        return 1;
+    }
+    if (bPool->whenAny(std::vector<TypedFuture<int64_t>>()).get().index 
+            != SIZE_MAX || 
+            !bPool->whenAll(std::vector<TypedFuture<void>>()).get().empty()) {
+        std::fprintf(stderr, "wrong result for no tasks\n");
+        return 1;
+    }
+
+    double blockingSecs = duration_cast<nanoseconds>(mid - start).count() / 1e9;
+    double chainedSecs = duration_cast<nanoseconds>(end - mid).count() / 1e9;
+    std::printf(
+        "get in tasks: %8.0lf requests/s, then/whenAll: %8.0lf requests/s\n",
+        N_REQUESTS / blockingSecs,
+        N_REQUESTS / chainedSecs
+    );
+    std::fflush(stdout);
+
+    return 0;
+}
@@ -0,0 +1,100 @@
+
+/**
+ * ExternalSubmit.cxx
+ * 
+ * Measures how many tiny tasks external (non-worker) threads can push 
+ * through a Winpool per second as the number of submitting threads grows.
+ */
+
+
+
+#include <memory>
+#include <cstdio>
+#include <chrono>
+#include <winpool.hxx>
+
+
+
+using namespace WinpoolNS;
+using namespace std::chrono;
+
+
+
+/* N_TASKS_PER_PRODUCER: Number of tasks each producer thread submits. */
+#define N_TASKS_PER_PRODUCER 20000
+
+/* BATCH_SIZE: Number of tasks a producer submits before joining them. */
+#define BATCH_SIZE 64
+
+/* MAX_PRODUCERS: Largest producer count to try. */
+#define MAX_PRODUCERS 32
+
+
+
+/**
+ * producerProc
+ * 
+ * Producer thread: submits N_TASKS_PER_PRODUCER empty tasks in batches and
+ * joins each batch.
+ * 
+ * arg: Borrowed pointer to the Winpool to submit to.
+ */
+static void producerProc(void *arg) {
+
+    Winpool *bPool = (Winpool *)arg;
+    TypedFuture<void> batch[BATCH_SIZE];
+
+    for (int iTask = 0; iTask < N_TASKS_PER_PRODUCER; iTask += BATCH_SIZE) {
+        for (int i = 0; i < BATCH_SIZE; i++) {
+            batch[i] = bPool->submit([]() {});
+        }
+        for (int i = 0; i < BATCH_SIZE; i++) {
+            batch[i].get();
+        }
+    }
+}
+
+
+
+/**
+ * main
+ * 
+ * Execution starts here.
+ */
+int main() {
+
+    UniquePtr<Winpool> pool;
+    try {
+        pool = Winpool::createNew(16);
+    }
+    catch (SyscallError e) {
+        std::fprintf(stderr, "syscall failure Winpool::createNew\n");
+        std::fflush(stderr);
+        return 1;
+    }
+
+    for (int nProducers = 1; nProducers <= MAX_PRODUCERS; nProducers *= 2) {
+
+        UniquePtr<Thread[]> producers(new Thread[nProducers]);
+
+        steady_clock::time_point start = steady_clock::now();
+        for (int i = 0; i < nProducers; i++) {
+            producers[i].start(producerProc, pool.get());
+        }
+        for (int i = 0; i < nProducers; i++) {
+            producers[i].join();
+        }
+        steady_clock::time_point end = steady_clock::now();
+
+        double secs = duration_cast<nanoseconds>(end - start).count() / 1e9;
+        double nTasks = (double)nProducers * N_TASKS_PER_PRODUCER;
+        std::printf(
+            "%2d producers: %10.0lf tasks/s\n", 
+            nProducers, 
+            nTasks / secs
+        );
+        std::fflush(stdout);
+    }
+
+    return 0;
+}
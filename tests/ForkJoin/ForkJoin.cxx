@@ -0,0 +1,172 @@
+/**
+ * ForkJoin.cxx
+ * 
+ * Walks a wide tree of tasks, every node forking all its children and 
+ * joining them, once with a TypedFuture per child and once with a 
+ * TaskGroup per node, and compares the nodes visited per second.
+ */
+
+
+
+#include <memory>
+#include <atomic>
+#include <cstdio>
+#include <chrono>
+#include <winpool.hxx>
+
+
+
+using namespace WinpoolNS;
+using namespace std::chrono;
+
+
+
+/* FANOUT: Children per inner node. */
+#define FANOUT 8
+
+/* DEPTH: Levels of inner nodes below the root. */
+#define DEPTH 6
+
+/* N_ROUNDS: Number of times each tree walk is timed. */
+#define N_ROUNDS 5
+
+
+
+/* nLeaves: Counts the leaves visited. */
+static std::atomic<int64_t> nLeaves(0);
+
+
+
+/**
+ * walkFutures
+ * 
+ * Winpool task visiting a node depth levels above the leaves, joining its
+ * children with one TypedFuture each.
+ */
+static void walkFutures(Winpool *bPool, int depth) {
+
+    if (depth == 0) {
+        nLeaves.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    TypedFuture<void> childFuts[FANOUT];
+    for (int iChild = 0; iChild < FANOUT; iChild++) {
+        childFuts[iChild] = bPool->submit(walkFutures, bPool, depth - 1);
+    }
+    for (int iChild = 0; iChild < FANOUT; iChild++) {
+        childFuts[iChild].get();
+    }
+}
+
+
+
+/**
+ * walkGroup
+ * 
+ * Winpool task visiting a node depth levels above the leaves, joining its
+ * children with one TaskGroup.
+ */
+static void walkGroup(Winpool *bPool, int depth) {
+
+    if (depth == 0) {
+        nLeaves.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    TaskGroup group(bPool);
+    for (int iChild = 0; iChild < FANOUT; iChild++) {
+        group.run(walkGroup, bPool, depth - 1);
+    }
+    group.wait();
+}
+
+
+
+/**
+ * measure
+ * 
+ * Times N_ROUNDS walks of the tree with walk, submitted from this 
+ * (external) thread, and returns the nodes visited per second, or -1 if a
+ * walk missed leaves.
+ */
+static double measure(Winpool *bPool, void (*walk)(Winpool *, int)) {
+
+    int64_t nNodes = 0;
+    int64_t levelNodes = 1;
+    for (int iLevel = 0; iLevel <= DEPTH; iLevel++) {
+        nNodes += levelNodes;
+        levelNodes *= FANOUT;
+    }
+    int64_t nTreeLeaves = levelNodes / FANOUT;
+
+    steady_clock::time_point start = steady_clock::now();
+    for (int iRound = 0; iRound < N_ROUNDS; iRound++) {
+        nLeaves.store(0, std::memory_order_relaxed);
+        bPool->submit(walk, bPool, DEPTH).get();
+        if (nLeaves.load(std::memory_order_relaxed) != nTreeLeaves)
+            return -1;
+    }
+    steady_clock::time_point end = steady_clock::now();
+
+    double secs = duration_cast<nanoseconds>(end - start).count() / 1e9;
+    return N_ROUNDS * nNodes / secs;
+}
+
+
+
+/**
+ * main
+ * 
+ * Execution starts here.
+ */
+int main() {
+
+    UniquePtr<Winpool> pool;
+    try {
+        pool = Winpool::createNew(16);
+    }
+    catch (SyscallError e) {
+        std::fprintf(stderr, "syscall failure Winpool::createNew\n");
+        std::fflush(stderr);
+        return 1;
+    }
+
+    double futuresRate = measure(pool.get(), walkFutures);
+    double groupRate = measure(pool.get(), walkGroup);
+    if (futuresRate < 0 || groupRate < 0) {
+        std::fprintf(stderr, "tree walk missed leaves\n");
+        return 1;
+    }
+
+    // A group waited on from an external thread sleeps until its children
+    // are done, and its destructor waits too
+    nLeaves.store(0, std::memory_order_relaxed);
+    {
+        TaskGroup group(pool.get());
+        for (int iChild = 0; iChild < FANOUT; iChild++) {
+            group.run(walkGroup, pool.get(), 2);
+        }
+        group.wait();
+        int64_t nDone = nLeaves.load(std::memory_order_relaxed);
+        if (!group.done() || nDone != FANOUT * FANOUT * FANOUT) {
+            std::fprintf(stderr, "external TaskGroup::wait returned early\n");
+            return 1;
+        }
+        group.run(walkGroup, pool.get(), 2);
+    }
+    if (nLeaves.load(std::memory_order_relaxed) != 
+            FANOUT * FANOUT * FANOUT + FANOUT * FANOUT) {
+        std::fprintf(stderr, "TaskGroup destructor didn't wait\n");
+        return 1;
+    }
+
+    std::printf(
+        "Future per child: %10.0lf nodes/s, TaskGroup: %10.0lf nodes/s\n",
+        futuresRate,
+        groupRate
+    );
+    std::fflush(stdout);
+
+    return 0;
+}
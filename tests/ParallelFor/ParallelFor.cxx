@@ -0,0 +1,175 @@
+/**
+ * ParallelFor.cxx
+ * 
+ * Compares parallelReduce with the hand-written fixed-grain recursion from
+ * ArrSum on array sums of very different sizes, and checks parallelFor.
+ */
+
+
+
+#include <memory>
+#include <cstdio>
+#include <chrono>
+#include <winpool.hxx>
+
+
+
+using namespace WinpoolNS;
+using namespace std::chrono;
+
+
+
+/* MAX_LEN: Length of the biggest array summed. */
+#define MAX_LEN (32 * 1024 * 1024)
+
+/* TOTAL_ELEMS: Each size is summed over and over until about this many
+                elements have been added up. */
+#define TOTAL_ELEMS (256LL * 1024 * 1024)
+
+
+
+/**
+ * sumFixed
+ * 
+ * Winpool task summing arr[iStart, iEnd) the way ArrSum does: halve, submit
+ * one half and recurse on the other down to a hard-coded 1000 elements.
+ */
+static int64_t sumFixed(Winpool *bPool,
+                        const int32_t *arr,
+                        size_t iStart,
+                        size_t iEnd) {
+
+    if (iEnd - iStart < 1000) {
+        int64_t sum = 0;
+        for (size_t i = iStart; i < iEnd; i++) {
+            sum += arr[i];
+        }
+        return sum;
+    }
+
+    size_t iMid = (iStart + iEnd) / 2;
+    TypedFuture<int64_t> half2Fut = bPool->submit(
+        sumFixed,
+        bPool,
+        arr,
+        iMid,
+        iEnd
+    );
+    int64_t half1Sum = sumFixed(bPool, arr, iStart, iMid);
+    return half1Sum + half2Fut.get();
+}
+
+
+
+/**
+ * sumLazy
+ * 
+ * Sums arr[0, len) with parallelReduce.
+ */
+static int64_t sumLazy(Winpool *bPool, const int32_t *arr, size_t len) {
+    return bPool->parallelReduce(
+        (size_t)0,
+        len,
+        (int64_t)0,
+        [arr](size_t lo, size_t hi, int64_t acc) {
+            for (size_t i = lo; i < hi; i++) {
+                acc += arr[i];
+            }
+            return acc;
+        },
+        [](int64_t left, int64_t right) {
+            return left + right;
+        }
+    );
+}
+
+
+
+/**
+ * measure
+ * 
+ * Sums the first len elements of arr with both methods, from inside a
+ * task, and prints the elements summed per second.
+ */
+static bool measure(Winpool *bPool, const int32_t *arr, size_t len) {
+
+    int64_t nRounds = TOTAL_ELEMS / (int64_t)len;
+    bool ok = true;
+
+    steady_clock::time_point start = steady_clock::now();
+    bPool->submit([&]() {
+        for (int64_t iRound = 0; iRound < nRounds; iRound++) {
+            ok &= sumFixed(bPool, arr, 0, len) == (int64_t)len;
+        }
+    }).get();
+    steady_clock::time_point mid = steady_clock::now();
+    bPool->submit([&]() {
+        for (int64_t iRound = 0; iRound < nRounds; iRound++) {
+            ok &= sumLazy(bPool, arr, len) == (int64_t)len;
+        }
+    }).get();
+    steady_clock::time_point end = steady_clock::now();
+
+    double fixedSecs = duration_cast<nanoseconds>(mid - start).count() / 1e9;
+    double lazySecs = duration_cast<nanoseconds>(end - mid).count() / 1e9;
+    std::printf(
+        "len %10zu: fixed grain %8.0lf M/s, parallelReduce %8.0lf M/s\n",
+        len,
+        (double)nRounds * len / fixedSecs / 1e6,
+        (double)nRounds * len / lazySecs / 1e6
+    );
+    std::fflush(stdout);
+
+    return ok;
+}
+
+
+
+/**
+ * main
+ * 
+ * Execution starts here.
+ */
+int main() {
+
+    UniquePtr<Winpool> pool;
+    try {
+        pool = Winpool::createNew(16);
+    }
+    catch (SyscallError e) {
+        std::fprintf(stderr, "syscall failure Winpool::createNew\n");
+        std::fflush(stderr);
+        return 1;
+    }
+
+    UniquePtr<int32_t[]> arr(new int32_t[MAX_LEN]);
+
+    // parallelFor from an external thread fills the array
+    pool->parallelFor(0, MAX_LEN, [&arr](int i) {
+        arr[i] = 1;
+    });
+    for (int i = 0; i < MAX_LEN; i++) {
+        if (arr[i] != 1) {
+            std::fprintf(stderr, "parallelFor missed element %d\n", i);
+            return 1;
+        }
+    }
+
+    // From an external thread too
+    if (sumLazy(pool.get(), arr.get(), MAX_LEN) != MAX_LEN) {
+        std::fprintf(stderr, "wrong external parallelReduce sum\n");
+        return 1;
+    }
+
+    bool ok = true;
+    for (size_t len = 16; len <= MAX_LEN; len *= 16) {
+        ok &= measure(pool.get(), arr.get(), len);
+    }
+
+    if (!ok) {
+        std::fprintf(stderr, "wrong sum\n");
+        return 1;
+    }
+
+    return 0;
+}
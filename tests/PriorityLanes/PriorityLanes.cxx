@@ -0,0 +1,142 @@
+/**
+ * PriorityLanes.cxx
+ *
+ * Measures how long an interactive task submitted by an external thread
+ * waits behind a backlog of batch work: with both in the default lane,
+ * then with the batch work in PRIORITY_LOW and the interactive task in
+ * PRIORITY_HIGH.
+ */
+
+
+
+#include <memory>
+#include <atomic>
+#include <cstdio>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+#include <inttypes.h>
+#include <winpool.hxx>
+
+
+
+using namespace WinpoolNS;
+using namespace std::chrono;
+
+
+
+/* N_SAMPLES: Number of interactive tasks timed per round. */
+#define N_SAMPLES 200
+
+/* BACKLOG_SIZE: Number of batch tasks queued ahead of each interactive
+                 task. */
+#define BACKLOG_SIZE 200
+
+/* BATCH_TASK_NS: Time each batch task spins for. */
+#define BATCH_TASK_NS 10000
+
+
+
+static int64_t nowNs() {
+    return duration_cast<nanoseconds>(
+        steady_clock::now().time_since_epoch()
+    ).count();
+}
+
+
+
+/**
+ * runRound
+ *
+ * Takes N_SAMPLES submit-to-start latencies of an interactive task queued
+ * with interactivePriority right behind BACKLOG_SIZE batch tasks queued
+ * with batchPriority. Returns the p99 latency in ns and puts the p50 in
+ * *p50Ns.
+ */
+static int64_t runRound(Winpool *bPool,
+                        TaskPriority batchPriority,
+                        TaskPriority interactivePriority,
+                        int64_t *p50Ns) {
+
+    int64_t latenciesNs[N_SAMPLES];
+
+    for (int iSample = 0; iSample < N_SAMPLES; iSample++) {
+
+        std::vector<TypedFuture<void>> backlog;
+        for (int iTask = 0; iTask < BACKLOG_SIZE; iTask++) {
+            backlog.push_back(bPool->submit(batchPriority, []() {
+                int64_t tEndNs = nowNs() + BATCH_TASK_NS;
+                while (nowNs() < tEndNs) {}
+            }));
+        }
+
+        int64_t tSubmitNs = nowNs();
+        latenciesNs[iSample] = bPool->submit(interactivePriority, []() {
+            return nowNs();
+        }).get() - tSubmitNs;
+
+        for (TypedFuture<void> &fut : backlog) {
+            fut.get();
+        }
+    }
+    std::sort(latenciesNs, latenciesNs + N_SAMPLES);
+
+    *p50Ns = latenciesNs[N_SAMPLES / 2];
+    return latenciesNs[N_SAMPLES * 99 / 100];
+}
+
+
+
+/**
+ * main
+ *
+ * Execution starts here.
+ */
+int main() {
+
+    UniquePtr<Winpool> pool;
+    try {
+        pool = Winpool::createNew(16);
+    }
+    catch (SyscallError e) {
+        std::fprintf(stderr, "syscall failure Winpool::createNew\n");
+        std::fflush(stderr);
+        return 1;
+    }
+
+    int64_t sameP50Ns;
+    int64_t sameP99Ns = runRound(
+        pool.get(),
+        PRIORITY_NORMAL,
+        PRIORITY_NORMAL,
+        &sameP50Ns
+    );
+    int64_t lanesP50Ns;
+    int64_t lanesP99Ns = runRound(
+        pool.get(),
+        PRIORITY_LOW,
+        PRIORITY_HIGH,
+        &lanesP50Ns
+    );
+
+    std::printf(
+        "interactive submit-to-start behind %d batch tasks:\n"
+            "  same lane:     p50 %10" PRId64 " ns, p99 %10" PRId64 " ns\n"
+            "  HIGH over LOW: p50 %10" PRId64 " ns, p99 %10" PRId64 " ns\n",
+        BACKLOG_SIZE,
+        sameP50Ns,
+        sameP99Ns,
+        lanesP50Ns,
+        lanesP99Ns
+    );
+    std::fflush(stdout);
+
+    // Behind the backlog, the interactive task waits for most of it; in
+    // its own lane it only waits for a worker to finish its current task
+    if (lanesP99Ns * 2 > sameP99Ns) {
+        std::fprintf(stderr, "HIGH tasks still waited for the backlog\n");
+        return 1;
+    }
+
+    return 0;
+}
@@ -102,105 +102,72 @@ static void quicksortSeq(int32_t *arr, size_t iStart, size_t iEnd) {
 
 
 
-class QuicksortArgs final {
-public:
-    Winpool *bpPool;
-    int32_t *arr;
-    size_t iStart;
-    size_t iEnd;
-
-    QuicksortArgs(Winpool *bpPool, int32_t *arr, size_t iStart, size_t iEnd);
-};
-
-
-QuicksortArgs::QuicksortArgs(Winpool *bpPool, 
-                             int32_t *arr, 
-                             size_t iStart, 
-                             size_t iEnd) {
-
-    this->bpPool = bpPool;
-    this->arr = arr;
-    this->iStart = iStart;
-    this->iEnd = iEnd;
-}
-
-
-
-static void *quicksortParallel(void *_arg) {
-
-    UniquePtr<QuicksortArgs> args((QuicksortArgs *)_arg);
-
-    //Worker *bpMyWorker = (Worker *)TlsGetValue(args->bpPool->workerTlsIdx);
-    //
-    //std::printf(
-    //    "worker %lu: quickSortParallel(%lu, %lu)\n",
-    //    bpMyWorker - args->bpPool->workers.get(),
-    //    args->iStart, 
-    //    args->iEnd);
-    //std::fflush(stdout);
+/**
+ * quicksortParallel
+ * 
+ * Winpool task that sorts a segment of an array with quicksort, sorting the
+ * right segment in a subtask.
+ * 
+ * bPool: Borrowed pointer to the Winpool this task is running on.
+ * arr: Entire array being sorted.
+ * iStart: Index into arr at which our segment to sort starts (inclusive).
+ * iEnd: Index into arr at which our segment to sort starts (exclusive).
+ */
+static void quicksortParallel(Winpool *bPool, 
+                              int32_t *arr, 
+                              size_t iStart, 
+                              size_t iEnd) {
 
-    if (args->iEnd - args->iStart <= 4096) {
-        quicksortSeq(args->arr, args->iStart, args->iEnd);
-        return nullptr;
+    if (iEnd - iStart <= 4096) {
+        quicksortSeq(arr, iStart, iEnd);
+        return;
     }
 
-    int32_t pivot = args->arr[args->iStart];
+    int32_t pivot = arr[iStart];
 
-    size_t iLeft = args->iStart + 1;
-    size_t iRight = args->iEnd - 1;
+    size_t iLeft = iStart + 1;
+    size_t iRight = iEnd - 1;
 
     while (iLeft <= iRight) {
 
         // Find the elements that need to be swapped
-        while (iLeft <= iRight && args->arr[iLeft] < pivot) {
+        while (iLeft <= iRight && arr[iLeft] < pivot) {
             iLeft++;
         }
-        while (iRight >= iLeft && args->arr[iRight] >= pivot) {
+        while (iRight >= iLeft && arr[iRight] >= pivot) {
             iRight--;
         }
 
         // Perform the swap
         if (iLeft < iRight) {
-            int32_t tmp = args->arr[iLeft];
-            args->arr[iLeft] = args->arr[iRight];
-            args->arr[iRight] = tmp;
+            int32_t tmp = arr[iLeft];
+            arr[iLeft] = arr[iRight];
+            arr[iRight] = tmp;
             iLeft++;
             iRight--;
         }
     }
 
     // Put the pivot in the proper spot
-    if (iRight > args->iStart) {
-        args->arr[args->iStart] = args->arr[iRight];
-        args->arr[iRight] = pivot;
+    if (iRight > iStart) {
+        arr[iStart] = arr[iRight];
+        arr[iRight] = pivot;
     }
 
     // iRight now points to the first element in the right segment
 
     // Make the recursive calls on the left and right segments
-    Future *bpRightFut = args->bpPool->submit(
+    TypedFuture<void> rightFut = bPool->submit(
         quicksortParallel,
-        new QuicksortArgs(
-            args->bpPool, 
-            args->arr, 
-            iRight + 1, 
-            args->iEnd
-        )
-    );
-    quicksortParallel(
-        new QuicksortArgs(
-            args->bpPool, 
-            args->arr, 
-            args->iStart, 
-            iRight
-        )
+        bPool, 
+        arr, 
+        iRight + 1, 
+        iEnd
     );
+    quicksortParallel(bPool, arr, iStart, iRight);
     
     // Join the subtask
-    UniquePtr<Future> rightFut;
-    bpRightFut->get(&rightFut);
-
-    return nullptr;
+    rightFut.get();
 }
 
 
@@ -259,12 +226,14 @@ int main() {
         TimePoint start = high_resolution_clock::now();
 
         // Sort array
-        UniquePtr<Future> fut;
-        Future *bpFut = pool->submit(
+        TypedFuture<void> fut = pool->submit(
             quicksortParallel,
-            new QuicksortArgs(pool.get(), arr.get(), 0, ARR_SIZE) 
+            pool.get(), 
+            arr.get(), 
+            (size_t)0, 
+            (size_t)ARR_SIZE
         );
-        bpFut->get(&fut);
+        fut.get();
 
         // Stop timer
         TimePoint end = high_resolution_clock::now();
@@ -277,6 +246,26 @@ int main() {
         printArr(arr.get(), 20);
         assert(isSorted(arr.get(), ARR_SIZE));
         std::printf("Passed in %lf seconds!\n", secs);
+
+        // Once the pool warms up, spawning shouldn't allocate any chunks
+        AllocatorStats allocStats = pool->allocatorStats();
+        std::printf(
+            "Future chunks: %" PRIu64 ", slab allocs: %" PRIu64 
+            ", remote frees: %" PRIu64 "\n",
+            allocStats.nChunks,
+            allocStats.nAllocs,
+            allocStats.nRemoteFrees
+        );
+
+        // Joins should keep finding work instead of yielding
+        JoinStats joinStats = pool->joinStats();
+        std::printf(
+            "Join waits: %" PRIu64 ", tasks run while joining: %" PRIu64 
+            ", wasted join time: %lf seconds\n",
+            joinStats.nWaits,
+            joinStats.nHelps,
+            (double)joinStats.wastedNs / (double)BILLION
+        );
         std::printf("\n");
         std::fflush(stdout);
     }
@@ -0,0 +1,185 @@
+/**
+ * SchedulerStats.cxx
+ *
+ * Runs a fork-join workload and prints the per-worker scheduler counters
+ * Winpool::stats reports for it, checks they add up, and measures what a
+ * call to stats costs while the pool is busy.
+ */
+
+
+
+#include <memory>
+#include <atomic>
+#include <cstdio>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <inttypes.h>
+#include <winpool.hxx>
+
+
+
+using namespace WinpoolNS;
+using namespace std::chrono;
+
+
+
+/* FANOUT: Number of children of every inner task. */
+#define FANOUT 4
+
+/* DEPTH: Number of levels of inner tasks above the leaves. */
+#define DEPTH 7
+
+/* LEAF_ITERS: Hashing steps each leaf task does. */
+#define LEAF_ITERS 2000
+
+/* N_SCRAPES: Number of stats calls timed while the pool is busy. */
+#define N_SCRAPES 1000
+
+
+
+/**
+ * runNode
+ *
+ * Runs the subtree of depth levels under a task: an inner task submits one
+ * task per child and joins them, a leaf hashes for a while. Returns the
+ * hash, so it isn't optimized away, and adds the number of tasks submitted
+ * to *nSubmitted.
+ */
+static uint64_t runNode(Winpool *bPool,
+                        uint64_t seed,
+                        int depth,
+                        std::atomic<uint64_t> *nSubmitted) {
+
+    if (depth == 0) {
+        uint64_t hash = seed;
+        for (int i = 0; i < LEAF_ITERS; i++) {
+            hash = (hash ^ (hash >> 31)) * 0x9E3779B97F4A7C15ull;
+        }
+        return hash;
+    }
+
+    TypedFuture<uint64_t> children[FANOUT];
+    for (int iChild = 0; iChild < FANOUT; iChild++) {
+        uint64_t childSeed = seed * FANOUT + iChild;
+        children[iChild] = bPool->submit(
+            [bPool, childSeed, depth, nSubmitted]() {
+                return runNode(bPool, childSeed, depth - 1, nSubmitted);
+            }
+        );
+    }
+    nSubmitted->fetch_add(FANOUT, std::memory_order_relaxed);
+
+    uint64_t hash = 0;
+    for (int iChild = 0; iChild < FANOUT; iChild++) {
+        hash ^= children[iChild].get();
+    }
+    return hash;
+}
+
+
+
+/**
+ * main
+ *
+ * Execution starts here.
+ */
+int main() {
+
+    UniquePtr<Winpool> pool;
+    try {
+        pool = Winpool::createNew(16);
+    }
+    catch (SyscallError e) {
+        std::fprintf(stderr, "syscall failure Winpool::createNew\n");
+        std::fflush(stderr);
+        return 1;
+    }
+
+    Winpool *bPool = pool.get();
+
+    // Scrape the counters over and over while the workload runs
+    std::atomic<uint64_t> nSubmitted(1);
+    std::atomic<bool> done(false);
+    std::thread workload([bPool, &nSubmitted, &done]() {
+        uint64_t hash = bPool->submit([bPool, &nSubmitted]() {
+            return runNode(bPool, 1, DEPTH, &nSubmitted);
+        }).get();
+        std::printf("workload hash: %016" PRIx64 "\n", hash);
+        done.store(true);
+    });
+
+    steady_clock::time_point start = steady_clock::now();
+    int nScrapes = 0;
+    while (nScrapes < N_SCRAPES && !done.load()) {
+        SchedulerStats stats = bPool->stats();
+        if (stats.workers.empty()) {
+            std::fprintf(stderr, "stats reported no workers\n");
+            return 1;
+        }
+        nScrapes++;
+    }
+    steady_clock::time_point end = steady_clock::now();
+    workload.join();
+
+    std::printf(
+        "stats() while busy: %.0lf ns per call over %d calls\n",
+        (double)duration_cast<nanoseconds>(end - start).count() / nScrapes,
+        nScrapes
+    );
+
+    SchedulerStats stats = bPool->stats();
+    std::printf(
+        "%6s %8s %8s %8s %8s %8s %8s %10s %8s %10s\n",
+        "worker",
+        "tasks",
+        "pops",
+        "tries",
+        "steals",
+        "yields",
+        "sleeps",
+        "sleep ms",
+        "joins",
+        "join ms"
+    );
+    for (size_t iWorker = 0; iWorker < stats.workers.size(); iWorker++) {
+        const WorkerStats &counters = stats.workers[iWorker];
+        std::printf(
+            "%6zu %8" PRIu64 " %8" PRIu64 " %8" PRIu64 " %8" PRIu64
+                " %8" PRIu64 " %8" PRIu64 " %10.1lf %8" PRIu64 " %10.1lf\n",
+            iWorker,
+            counters.nTasks,
+            counters.nQueuePops,
+            counters.nStealAttempts,
+            counters.nSteals,
+            counters.nYields,
+            counters.nSleeps,
+            counters.sleepNs / 1e6,
+            counters.nJoinWaits,
+            counters.joinNs / 1e6
+        );
+    }
+    std::printf(
+        "total: %" PRIu64 " tasks for %" PRIu64 " submitted, %" PRIu64
+            " steals in %" PRIu64 " tries, %.1lf ms wasted joining\n",
+        stats.total.nTasks,
+        nSubmitted.load(),
+        stats.total.nSteals,
+        stats.total.nStealAttempts,
+        stats.total.joinWastedNs / 1e6
+    );
+    std::fflush(stdout);
+
+    // Every submitted task ran on some worker, and a steal needs a try
+    if (stats.total.nTasks < nSubmitted.load()) {
+        std::fprintf(stderr, "tasks went uncounted\n");
+        return 1;
+    }
+    if (stats.total.nSteals > stats.total.nStealAttempts ||
+            stats.total.joinWastedNs > stats.total.joinNs) {
+        std::fprintf(stderr, "counters don't add up\n");
+        return 1;
+    }
+
+    return 0;
+}
@@ -29,12 +29,33 @@ using namespace WinpoolNS;
 Future::Future(WinpoolTask func, 
                void *arg, 
                Winpool *bPool, 
-               FutureOwner *owner) {
+               FutureOwner *owner) :
+        Future(bPool) {
     
-    this->func = func;
     this->arg = arg;
-    this->bPool = bPool;
     this->owner = owner;
+    this->setTask([func = std::move(func), arg]() { return func(arg); });
+}
+
+
+
+/**
+ * Future task-less constructor
+ * 
+ * bPool: Borrowed pointer to the pool.
+ */
+Future::Future(Winpool *bPool) {
+
+    this->arg = nullptr;
+    this->bPool = bPool;
+    this->owner = nullptr;
+    this->invokeTask = nullptr;
+    this->destroyTask = nullptr;
+    this->detached = false;
+    this->priority = PRIORITY_NORMAL;
+    this->cancellable = false;
+    this->cancelled = false;
+    this->token = nullptr;
 }
 
 
@@ -55,16 +76,49 @@ Future::Future(WinpoolTask func,
  */
 void *Future::get(UniquePtr<Future> *newOwner) {
     
-    this->res = this->func(this->arg);
+    void *res = this->join();
 
     if (newOwner != nullptr)
         *newOwner = UniquePtr<Future>(this);
+    else
+        delete this;
+
+    return res;
+}
+
+
+
+/**
+ * Future::join
+ * 
+ * Runs the task if it hasn't run yet.
+ * 
+ * Return Value: Returns the result returned by this Future's task.
+ */
+void *Future::join() {
+
+    if (this->invokeTask != nullptr) {
+        this->invokeTask(this);
+        this->invokeTask = nullptr;
+    }
 
     return this->res;
 }
 
 
 
+/**
+ * Future::release
+ * 
+ * Runs the task if it hasn't run yet, then deletes this Future.
+ */
+void Future::release() {
+    this->join();
+    delete this;
+}
+
+
+
 /**
  * Winpool::createNew
  * 
@@ -84,6 +138,17 @@ UniquePtr<Winpool> Winpool::createNew(int nThreads) {
 
 
 
+/**
+ * Winpool destructor
+ * 
+ * There are no threads to stop: tasks run when they're waited for.
+ */
+Winpool::~Winpool() {
+    // Do nothing
+}
+
+
+
 /**
  * Winpool::submit
  * 
@@ -101,26 +166,59 @@ UniquePtr<Winpool> Winpool::createNew(int nThreads) {
  */
 Future *Winpool::submit(WinpoolTask func, void *arg) {
 
-    Future *fut = new Future(func, arg, this, nullptr);
+    Future *fut = new Future(std::move(func), arg, this, nullptr);
     return fut;
 }
 
 
 
+/**
+ * Winpool::submitFuture
+ * 
+ * fut: Future with its task set, with ownership passed to this function.
+ * 
+ * Return Value: Returns a pointer to fut. The task runs when get is called,
+ *               or right away if fut is detached (nobody will call get).
+ */
+Future *Winpool::submitFuture(UniquePtr<Future> fut) {
+    if (fut->detached) {
+        fut.release()->release();
+        return nullptr;
+    }
+    return fut.release();
+}
+
+
+
 Future::Future(bool sentinel) {
-    this->status = SENTINEL;
+    this->status.store(SENTINEL, std::memory_order_relaxed);
+    this->queueNext.store(nullptr, std::memory_order_relaxed);
+    this->detached = false;
+    this->priority = PRIORITY_NORMAL;
+    this->cancellable = false;
+    this->cancelled = false;
+    this->token = nullptr;
+    this->invokeTask = nullptr;
+    this->destroyTask = nullptr;
 }
 
 
 
 Future::~Future() {
-    // Do nothing
+    if (this->destroyTask != nullptr)
+        this->destroyTask(this);
 }
 
 
 
 Worker::Worker() {
-    // Do nothing
+    this->slab = new FutureSlab();
+}
+
+
+
+InjectionQueue::InjectionQueue() {
+    this->nShards = 0;
 }
 
 
@@ -0,0 +1,105 @@
+
+/**
+ * SubmitLatency.cxx
+ * 
+ * Measures how much CPU an idle Winpool burns and how long it takes a 
+ * sleeping pool to start a task submitted by an external thread.
+ */
+
+
+
+#include <memory>
+#include <atomic>
+#include <cstdio>
+#include <ctime>
+#include <chrono>
+#include <algorithm>
+#include <inttypes.h>
+#include <winpool.hxx>
+
+
+
+using namespace WinpoolNS;
+using namespace std::chrono;
+
+
+
+/* N_SAMPLES: Number of submit-to-start latency samples to take. */
+#define N_SAMPLES 200
+
+
+
+/* tStartNs: Time the latest task started, in ns since the clock's epoch. */
+static std::atomic<int64_t> tStartNs;
+
+
+
+static int64_t nowNs() {
+    return duration_cast<nanoseconds>(
+        steady_clock::now().time_since_epoch()
+    ).count();
+}
+
+
+
+/**
+ * stampStart
+ * 
+ * Winpool task that just records when it started.
+ */
+static void *stampStart(void *arg) {
+    tStartNs.store(nowNs());
+    return nullptr;
+}
+
+
+
+/**
+ * main
+ * 
+ * Execution starts here.
+ */
+int main() {
+
+    UniquePtr<Winpool> pool;
+    try {
+        pool = Winpool::createNew(16);
+    }
+    catch (SyscallError e) {
+        std::fprintf(stderr, "syscall failure Winpool::createNew\n");
+        std::fflush(stderr);
+        return 1;
+    }
+
+    // Let the pool go idle, then see how much CPU it uses doing nothing
+    sleepMs(100);
+    std::clock_t cpuStart = std::clock();
+    sleepMs(1000);
+    std::clock_t cpuEnd = std::clock();
+    double idleCpuMs = 
+        1000.0 * (double)(cpuEnd - cpuStart) / (double)CLOCKS_PER_SEC;
+
+    // Submit to a sleeping pool and time how long the task takes to start
+    int64_t latenciesNs[N_SAMPLES];
+    for (int iSample = 0; iSample < N_SAMPLES; iSample++) {
+        sleepMs(5);
+
+        int64_t tSubmitNs = nowNs();
+        UniquePtr<Future> fut;
+        Future *bFut = pool->submit(stampStart, nullptr);
+        bFut->get(&fut);
+
+        latenciesNs[iSample] = tStartNs.load() - tSubmitNs;
+    }
+    std::sort(latenciesNs, latenciesNs + N_SAMPLES);
+
+    // Print results
+    std::printf("idle CPU time over 1 s: %lf ms\n", idleCpuMs);
+    std::printf(
+        "submit-to-start latency: p50 %" PRId64 " ns, p99 %" PRId64 " ns\n",
+        latenciesNs[N_SAMPLES / 2],
+        latenciesNs[N_SAMPLES * 99 / 100]
+    );
+
+    return 0;
+}
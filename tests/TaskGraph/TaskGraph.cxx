@@ -0,0 +1,174 @@
+/**
+ * TaskGraph.cxx
+ * 
+ * Runs the same layered dependency graph over and over, once re-submitting
+ * every node and joining each layer with get, once as a TaskGraph built 
+ * once and launched every iteration, and compares the iterations per 
+ * second. Checks that every node sees its dependencies done and that 
+ * TaskGraph runs allocate no Futures.
+ */
+
+
+
+#include <memory>
+#include <atomic>
+#include <cstdio>
+#include <chrono>
+#include <inttypes.h>
+#include <winpool.hxx>
+
+
+
+using namespace WinpoolNS;
+using namespace std::chrono;
+
+
+
+/* N_LAYERS: Number of layers in the graph. */
+#define N_LAYERS 4
+
+/* LAYER_WIDTH: Number of nodes per layer. Each depends on the node below
+                it and its right neighbour in the layer before. */
+#define LAYER_WIDTH 8
+
+/* N_ITERATIONS: Number of times the graph runs per method. */
+#define N_ITERATIONS 5000
+
+
+
+/* nRuns: How many times each node has run. */
+static std::atomic<int64_t> nRuns[N_LAYERS][LAYER_WIDTH];
+
+/* nOutOfOrder: Counts nodes that ran before one of their dependencies. */
+static std::atomic<int64_t> nOutOfOrder(0);
+
+
+
+/**
+ * runNode
+ * 
+ * Body of node (iLayer, iNode) in iteration iIter: checks its dependencies
+ * ran this iteration and counts itself.
+ */
+static void runNode(int iLayer, int iNode, int64_t iIter) {
+    if (iLayer > 0) {
+        for (int iDep = iNode; iDep <= iNode + 1; iDep++) {
+            if (nRuns[iLayer - 1][iDep % LAYER_WIDTH].load(
+                    std::memory_order_relaxed) != iIter + 1) {
+                nOutOfOrder.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+    nRuns[iLayer][iNode].fetch_add(1, std::memory_order_relaxed);
+}
+
+
+
+/**
+ * resetRuns
+ * 
+ * Zeroes nRuns between methods.
+ */
+static void resetRuns() {
+    for (int iLayer = 0; iLayer < N_LAYERS; iLayer++) {
+        for (int iNode = 0; iNode < LAYER_WIDTH; iNode++) {
+            nRuns[iLayer][iNode].store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+
+
+/**
+ * main
+ * 
+ * Execution starts here.
+ */
+int main() {
+
+    UniquePtr<Winpool> pool;
+    try {
+        pool = Winpool::createNew(16);
+    }
+    catch (SyscallError e) {
+        std::fprintf(stderr, "syscall failure Winpool::createNew\n");
+        std::fflush(stderr);
+        return 1;
+    }
+    Winpool *bPool = pool.get();
+
+    // Every iteration re-submits every node and joins layer by layer
+    resetRuns();
+    steady_clock::time_point start = steady_clock::now();
+    bPool->submit([bPool]() {
+        for (int64_t iIter = 0; iIter < N_ITERATIONS; iIter++) {
+            for (int iLayer = 0; iLayer < N_LAYERS; iLayer++) {
+                TypedFuture<void> layer[LAYER_WIDTH];
+                for (int iNode = 0; iNode < LAYER_WIDTH; iNode++) {
+                    layer[iNode] = bPool->submit(runNode, iLayer, iNode, iIter);
+                }
+                for (int iNode = 0; iNode < LAYER_WIDTH; iNode++) {
+                    layer[iNode].get();
+                }
+            }
+        }
+    }).get();
+    steady_clock::time_point mid = steady_clock::now();
+
+    // The same graph, declared once
+    resetRuns();
+    int64_t iIter = 0;
+    TaskGraph graph(bPool);
+    uint32_t nodes[N_LAYERS][LAYER_WIDTH];
+    for (int iLayer = 0; iLayer < N_LAYERS; iLayer++) {
+        for (int iNode = 0; iNode < LAYER_WIDTH; iNode++) {
+            nodes[iLayer][iNode] = graph.addNode([iLayer, iNode, &iIter]() {
+                runNode(iLayer, iNode, iIter);
+            });
+            if (iLayer > 0) {
+                for (int iDep = iNode; iDep <= iNode + 1; iDep++) {
+                    graph.addEdge(nodes[iLayer - 1][iDep % LAYER_WIDTH], 
+                                  nodes[iLayer][iNode]);
+                }
+            }
+        }
+    }
+    graph.launch();
+    graph.wait();
+    iIter++;
+
+    uint64_t nAllocsBefore = bPool->allocatorStats().nAllocs;
+    steady_clock::time_point graphStart = steady_clock::now();
+    bPool->submit([&graph, &iIter]() {
+        for (; iIter < N_ITERATIONS; iIter++) {
+            graph.launch();
+            graph.wait();
+        }
+    }).get();
+    steady_clock::time_point end = steady_clock::now();
+    // The submit above is the only Future allocated
+    uint64_t nRunAllocs = bPool->allocatorStats().nAllocs - nAllocsBefore;
+
+    if (nOutOfOrder.load() != 0 || 
+            nRuns[N_LAYERS - 1][0].load() != N_ITERATIONS) {
+        std::fprintf(stderr, "nodes ran out of order\n");
+        return 1;
+    }
+    if (nRunAllocs > 1) {
+        std::fprintf(stderr, "graph runs allocated %" PRIu64 " Futures\n",
+                     nRunAllocs);
+        return 1;
+    }
+
+    double submitSecs = duration_cast<nanoseconds>(mid - start).count() / 1e9;
+    double graphSecs = 
+        duration_cast<nanoseconds>(end - graphStart).count() / 1e9;
+    std::printf(
+        "submit + get: %8.0lf iterations/s, TaskGraph: %8.0lf iterations/s\n",
+        N_ITERATIONS / submitSecs,
+        (N_ITERATIONS - 1) / graphSecs
+    );
+    std::fflush(stdout);
+
+    return 0;
+}
@@ -0,0 +1,185 @@
+/**
+ * Teardown.cxx
+ *
+ * Measures how long it takes to shut a pool down: idle, with parked 
+ * workers and armed timers, and with a backlog of queued tasks, which 
+ * SHUTDOWN_DRAIN runs and SHUTDOWN_FAST skips. Checks that every task was
+ * either run or completed as cancelled, so nobody waiting is stranded.
+ */
+
+
+
+#include <memory>
+#include <atomic>
+#include <cstdio>
+#include <vector>
+#include <winpool.hxx>
+
+
+
+using namespace WinpoolNS;
+
+
+
+/* N_POOLS: Number of idle pools created and destroyed. */
+#define N_POOLS 100
+
+/* N_TASKS: Number of tasks queued before a shutdown. */
+#define N_TASKS 2000
+
+/* TASK_NS: Time each queued task spins for. */
+#define TASK_NS 50000
+
+
+
+/**
+ * createPool
+ *
+ * Creates a pool, or returns nullptr after printing an error.
+ */
+static UniquePtr<Winpool> createPool(int nThreads, int maxThreads) {
+    try {
+        return Winpool::createNew(nThreads, maxThreads);
+    }
+    catch (SyscallError e) {
+        std::fprintf(stderr, "syscall failure Winpool::createNew\n");
+        std::fflush(stderr);
+        return nullptr;
+    }
+}
+
+
+
+/**
+ * shutdownBacklog
+ *
+ * Queues N_TASKS tasks on a fresh pool, shuts it down in mode and prints
+ * how long that took and what became of the tasks. Returns the time in 
+ * ms, or -1 if a task was lost.
+ */
+static double shutdownBacklog(ShutdownMode mode) {
+
+    UniquePtr<Winpool> pool = createPool(16, 16);
+    if (pool == nullptr)
+        return -1;
+
+    std::atomic<int> nRan(0);
+    std::vector<TypedFuture<void>> futs;
+    for (int i = 0; i < N_TASKS; i++) {
+        futs.push_back(pool->submit([&nRan]() {
+            uint64_t endNs = monotonicNs() + TASK_NS;
+            while (monotonicNs() < endNs) {}
+            nRan.fetch_add(1);
+        }));
+    }
+
+    uint64_t startNs = monotonicNs();
+    pool->shutdown(mode);
+    double shutdownMs = (double)(monotonicNs() - startNs) / 1e6;
+
+    // Every Future is done by now: get never blocks
+    int nCancelled = 0;
+    for (TypedFuture<void> &fut : futs) {
+        if (!fut.waitFor(0)) {
+            std::fprintf(stderr, "a task wasn't done after shutdown\n");
+            return -1;
+        }
+        try {
+            fut.get();
+        }
+        catch (TaskCancelled &) {
+            nCancelled++;
+        }
+    }
+
+    std::printf(
+        "%s with %d tasks queued: %8.2lf ms, %d ran, %d cancelled\n",
+        mode == SHUTDOWN_DRAIN ? "drain" : "fast ",
+        N_TASKS,
+        shutdownMs,
+        nRan.load(),
+        nCancelled
+    );
+    std::fflush(stdout);
+
+    if (nRan.load() + nCancelled != N_TASKS || 
+            (mode == SHUTDOWN_DRAIN && nCancelled != 0)) {
+        std::fprintf(stderr, "tasks were lost in shutdown\n");
+        return -1;
+    }
+    return shutdownMs;
+}
+
+
+
+/**
+ * main
+ *
+ * Execution starts here.
+ */
+int main() {
+
+    // Idle pools, workers asleep
+    double totalMs = 0;
+    double worstMs = 0;
+    for (int iPool = 0; iPool < N_POOLS; iPool++) {
+        UniquePtr<Winpool> pool = createPool(16, 16);
+        if (pool == nullptr)
+            return 1;
+        pool->submit([]() {}).get();
+        sleepMs(1);
+
+        uint64_t startNs = monotonicNs();
+        pool.reset(nullptr);
+        double ms = (double)(monotonicNs() - startNs) / 1e6;
+        totalMs += ms;
+        worstMs = ms > worstMs ? ms : worstMs;
+    }
+    std::printf(
+        "idle pool of 16 destroyed: average %.3lf ms, worst %.3lf ms\n",
+        totalMs / N_POOLS,
+        worstMs
+    );
+    std::fflush(stdout);
+
+    // Parked workers, never-started slots and timers that are far off
+    UniquePtr<Winpool> pool = createPool(2, 16);
+    if (pool == nullptr)
+        return 1;
+    pool->setWorkerCount(8);
+    pool->submit([]() {}).get();
+    pool->setWorkerCount(2);
+    std::atomic<bool> timerFired(false);
+    pool->submitAfter(60000, [&timerFired]() { timerFired.store(true); });
+    TimerHandle periodic = pool->submitEvery(1, []() {});
+    sleepMs(20);
+    uint64_t startNs = monotonicNs();
+    pool->shutdown(SHUTDOWN_DRAIN);
+    double parkedMs = (double)(monotonicNs() - startNs) / 1e6;
+    std::printf(
+        "parked workers and armed timers: %.3lf ms\n",
+        parkedMs
+    );
+    std::fflush(stdout);
+    if (timerFired.load() || periodic.cancel()) {
+        std::fprintf(stderr, "timers outlived shutdown\n");
+        return 1;
+    }
+    if (pool->shutdown(SHUTDOWN_FAST)) {
+        std::fprintf(stderr, "shut down twice\n");
+        return 1;
+    }
+    pool.reset(nullptr);
+
+    // A backlog, drained then dropped
+    double drainMs = shutdownBacklog(SHUTDOWN_DRAIN);
+    double fastMs = shutdownBacklog(SHUTDOWN_FAST);
+    if (drainMs < 0 || fastMs < 0)
+        return 1;
+    if (fastMs * 2 > drainMs) {
+        std::fprintf(stderr, "fast shutdown didn't skip the backlog\n");
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,145 @@
+
+/**
+ * TestFutureDeque.cxx
+ */
+
+
+
+#include <memory>
+#include <atomic>
+#include <cassert>
+#include <cstdio>
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+void testDequePushPop() {
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wint-to-pointer-cast"
+
+    FutureDeque deque;
+
+    assert(deque.empty());
+    assert(deque.pop() == nullptr);
+
+    // Push enough to make the deque grow a couple of times
+    for (int n = 1; n <= 300; n++) {
+        deque.push(UniquePtr<Future>(
+            new Future(nullptr, (void *)n, nullptr, nullptr)
+        ));
+    }
+
+    // Owner pops newest first
+    for (int n = 300; n >= 1; n--) {
+        UniquePtr<Future> popped = deque.pop();
+        assert(popped != nullptr);
+        assert((void *)n == popped->arg);
+    }
+    assert(deque.empty());
+    assert(deque.pop() == nullptr);
+
+#pragma GCC diagnostic pop
+}
+
+
+
+void testDequeSteal() {
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wint-to-pointer-cast"
+
+    FutureDeque deque;
+
+    for (int n = 1; n <= 3; n++) {
+        deque.push(UniquePtr<Future>(
+            new Future(nullptr, (void *)n, nullptr, nullptr)
+        ));
+    }
+
+    // Thieves take oldest first, the owner newest
+    UniquePtr<Future> stolen = deque.steal();
+    assert(stolen->arg == (void *)1);
+    UniquePtr<Future> popped = deque.pop();
+    assert(popped->arg == (void *)3);
+    stolen = deque.steal();
+    assert(stolen->arg == (void *)2);
+    assert(deque.steal() == nullptr);
+    assert(deque.pop() == nullptr);
+
+#pragma GCC diagnostic pop
+}
+
+
+
+/**
+ * DequeStressData
+ * 
+ * Shared state for the owner and thieves in testDequeConcurrent.
+ */
+class DequeStressData final {
+public:
+    FutureDeque deque;
+    std::atomic<bool> done;
+    std::atomic<int64_t> nTaken;
+    std::atomic<int64_t> sumTaken;
+};
+
+
+
+static void dequeThiefProc(void *arg) {
+
+    DequeStressData *data = (DequeStressData *)arg;
+
+    while (!data->done.load() || !data->deque.empty()) {
+        UniquePtr<Future> stolen = data->deque.steal();
+        if (stolen != nullptr) {
+            data->nTaken.fetch_add(1);
+            data->sumTaken.fetch_add((int64_t)stolen->arg);
+        }
+    }
+}
+
+
+
+void testDequeConcurrent() {
+
+    const int nThieves = 3;
+    const int64_t nItems = 200000;
+
+    DequeStressData data;
+    data.done.store(false);
+    data.nTaken.store(0);
+    data.sumTaken.store(0);
+
+    Thread thieves[nThieves];
+    for (int i = 0; i < nThieves; i++) {
+        thieves[i].start(dequeThiefProc, &data);
+    }
+
+    // Owner pushes everything, popping every third element itself so pops 
+    // race the thieves
+    for (int64_t n = 1; n <= nItems; n++) {
+        data.deque.push(UniquePtr<Future>(
+            new Future(nullptr, (void *)n, nullptr, nullptr)
+        ));
+        if (n % 3 == 0) {
+            UniquePtr<Future> popped = data.deque.pop();
+            if (popped != nullptr) {
+                data.nTaken.fetch_add(1);
+                data.sumTaken.fetch_add((int64_t)popped->arg);
+            }
+        }
+    }
+    data.done.store(true);
+
+    for (int i = 0; i < nThieves; i++) {
+        thieves[i].join();
+    }
+
+    // Every element was taken exactly once
+    assert(data.nTaken.load() == nItems);
+    assert(data.sumTaken.load() == nItems * (nItems + 1) / 2);
+}
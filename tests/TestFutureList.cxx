@@ -23,11 +23,11 @@ void testInsertHead() {
     FutureList futList;
 
     UniquePtr<Future> f1 = 
-        UniquePtr<Future>(new Future(nullptr, (void *)1, nullptr));
+        UniquePtr<Future>(new Future(nullptr, (void *)1, nullptr, nullptr));
     UniquePtr<Future> f2 = 
-        UniquePtr<Future>(new Future(nullptr, (void *)2, nullptr));
+        UniquePtr<Future>(new Future(nullptr, (void *)2, nullptr, nullptr));
     UniquePtr<Future> f3 = 
-        UniquePtr<Future>(new Future(nullptr, (void *)3, nullptr));
+        UniquePtr<Future>(new Future(nullptr, (void *)3, nullptr, nullptr));
 
     // List should be 3, 2, 1
     futList.insertHead(std::move(f1));
@@ -55,11 +55,11 @@ void testInsertTail() {
     FutureList futList;
 
     UniquePtr<Future> f1 = 
-        UniquePtr<Future>(new Future(nullptr, (void *)1, nullptr));
+        UniquePtr<Future>(new Future(nullptr, (void *)1, nullptr, nullptr));
     UniquePtr<Future> f2 = 
-        UniquePtr<Future>(new Future(nullptr, (void *)2, nullptr));
+        UniquePtr<Future>(new Future(nullptr, (void *)2, nullptr, nullptr));
     UniquePtr<Future> f3 = 
-        UniquePtr<Future>(new Future(nullptr, (void *)3, nullptr));
+        UniquePtr<Future>(new Future(nullptr, (void *)3, nullptr, nullptr));
 
     // List is 1, 2, 3
     futList.insertTail(std::move(f1));
@@ -87,11 +87,11 @@ void testPopHead() {
     FutureList futList;
 
     UniquePtr<Future> f1 = 
-        UniquePtr<Future>(new Future(nullptr, (void *)1, nullptr));
+        UniquePtr<Future>(new Future(nullptr, (void *)1, nullptr, nullptr));
     UniquePtr<Future> f2 = 
-        UniquePtr<Future>(new Future(nullptr, (void *)2, nullptr));
+        UniquePtr<Future>(new Future(nullptr, (void *)2, nullptr, nullptr));
     UniquePtr<Future> f3 = 
-        UniquePtr<Future>(new Future(nullptr, (void *)3, nullptr));
+        UniquePtr<Future>(new Future(nullptr, (void *)3, nullptr, nullptr));
 
     // List is 1, 2, 3
     futList.insertTail(std::move(f1));
@@ -119,11 +119,11 @@ void testPopTail() {
     FutureList futList;
 
     UniquePtr<Future> f1 = 
-        UniquePtr<Future>(new Future(nullptr, (void *)1, nullptr));
+        UniquePtr<Future>(new Future(nullptr, (void *)1, nullptr, nullptr));
     UniquePtr<Future> f2 = 
-        UniquePtr<Future>(new Future(nullptr, (void *)2, nullptr));
+        UniquePtr<Future>(new Future(nullptr, (void *)2, nullptr, nullptr));
     UniquePtr<Future> f3 = 
-        UniquePtr<Future>(new Future(nullptr, (void *)3, nullptr));
+        UniquePtr<Future>(new Future(nullptr, (void *)3, nullptr, nullptr));
 
     // List is 1, 2, 3
     futList.insertTail(std::move(f1));
@@ -151,11 +151,11 @@ void testFuturePopFromList() {
     FutureList futList;
 
     UniquePtr<Future> oldFut1 = 
-        UniquePtr<Future>(new Future(nullptr, (void *)1, nullptr));
+        UniquePtr<Future>(new Future(nullptr, (void *)1, nullptr, nullptr));
     UniquePtr<Future> oldFut2 = 
-        UniquePtr<Future>(new Future(nullptr, (void *)2, nullptr));
+        UniquePtr<Future>(new Future(nullptr, (void *)2, nullptr, nullptr));
     UniquePtr<Future> oldFut3 = 
-        UniquePtr<Future>(new Future(nullptr, (void *)3, nullptr));
+        UniquePtr<Future>(new Future(nullptr, (void *)3, nullptr, nullptr));
 
     Future *bFut1 = oldFut1.get();
     Future *bFut2 = oldFut2.get();
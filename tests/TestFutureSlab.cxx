@@ -0,0 +1,107 @@
+
+/**
+ * TestFutureSlab.cxx
+ */
+
+
+
+#include <memory>
+#include <cassert>
+#include <cstdio>
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+void testSlabLocalReuse() {
+
+    FutureSlab *slab = new FutureSlab();
+    FutureSlab::tlsMySlab = slab;
+
+    Future *fut1 = new Future(nullptr, nullptr, nullptr, nullptr);
+    delete fut1;
+
+    // The freed block is the first one handed out again
+    Future *fut2 = new Future(nullptr, nullptr, nullptr, nullptr);
+    assert(fut2 == fut1);
+
+    AllocatorStats stats = { 0, 0, 0, 0 };
+    slab->collectStats(&stats);
+    assert(stats.nChunks == 1);
+    assert(stats.nAllocs == 2);
+    assert(stats.nLocalFrees == 1);
+    assert(stats.nRemoteFrees == 0);
+
+    delete fut2;
+    FutureSlab::tlsMySlab = nullptr;
+    slab->orphan();
+}
+
+
+
+static void deleteFutureProc(void *arg) {
+    delete (Future *)arg;
+}
+
+
+
+void testSlabRemoteFree() {
+
+    FutureSlab *slab = new FutureSlab();
+    FutureSlab::tlsMySlab = slab;
+
+    // Free a Future on another thread
+    Future *fut1 = new Future(nullptr, nullptr, nullptr, nullptr);
+    Thread remoteThread;
+    remoteThread.start(deleteFutureProc, fut1);
+    remoteThread.join();
+
+    AllocatorStats stats = { 0, 0, 0, 0 };
+    slab->collectStats(&stats);
+    assert(stats.nRemoteFrees == 1);
+
+    // The owner gets the block back once its own free list is empty
+    Future *fut2 = new Future(nullptr, nullptr, nullptr, nullptr);
+    assert(fut2 == fut1);
+
+    delete fut2;
+    FutureSlab::tlsMySlab = nullptr;
+    slab->orphan();
+}
+
+
+
+void testSlabSteadyState() {
+
+    FutureSlab *slab = new FutureSlab();
+    FutureSlab::tlsMySlab = slab;
+
+    // Spawning and freeing in waves never needs more than one chunk's worth
+    Future *futs[slabChunkBlocks];
+    for (int iWave = 0; iWave < 100; iWave++) {
+        for (int i = 0; i < slabChunkBlocks; i++) {
+            futs[i] = new Future(nullptr, nullptr, nullptr, nullptr);
+        }
+        for (int i = 0; i < slabChunkBlocks; i++) {
+            delete futs[i];
+        }
+    }
+
+    AllocatorStats stats = { 0, 0, 0, 0 };
+    slab->collectStats(&stats);
+    assert(stats.nChunks == 1);
+
+    // Orphaning while Futures are still out: the slab lives on until the
+    // last one is freed
+    for (int i = 0; i < slabChunkBlocks; i++) {
+        futs[i] = new Future(nullptr, nullptr, nullptr, nullptr);
+    }
+    FutureSlab::tlsMySlab = nullptr;
+    slab->orphan();
+    for (int i = 0; i < slabChunkBlocks; i++) {
+        delete futs[i];
+    }
+}
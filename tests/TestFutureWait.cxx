@@ -0,0 +1,52 @@
+/**
+ * TestFutureWait.cxx
+ */
+
+
+
+#include <memory>
+#include <cassert>
+#include <cstdint>
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+static void lateExecutorProc(void *arg) {
+    Worker executor;
+    sleepMs(50);
+    executeFuture(UniquePtr<Future>((Future *)arg), &executor);
+}
+
+
+
+void testFutureTimedWait() {
+
+    Future *fut = new Future((Winpool *)nullptr);
+    fut->setTask([]() { return (void *)7; });
+
+    // Nobody runs it: the waits time out, and not before their deadline
+    uint64_t startNs = monotonicNs();
+    assert(!fut->waitFor(2000000));
+    assert(monotonicNs() - startNs >= 2000000);
+    assert(!fut->waitUntil(startNs));
+    assert(!fut->waitFor(0));
+    assert(fut->nWaiters.load() == 0);
+
+    // Run it late on another thread: a long wait returns as soon as it's 
+    // done, with the result there to read
+    Thread executorThread;
+    executorThread.start(lateExecutorProc, fut);
+    startNs = monotonicNs();
+    assert(fut->waitFor(10000000000ULL));
+    assert(monotonicNs() - startNs < 5000000000ULL);
+    assert(fut->status.load() == DONE);
+    assert(fut->res == (void *)7);
+    assert(fut->waitUntil(0));
+    executorThread.join();
+
+    fut->release();
+}
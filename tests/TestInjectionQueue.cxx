@@ -0,0 +1,182 @@
+
+/**
+ * TestInjectionQueue.cxx
+ */
+
+
+
+#include <memory>
+#include <atomic>
+#include <cassert>
+#include <cstdio>
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+void testInjectionFifo() {
+
+    InjectionQueue queue;
+    assert(queue.pop(0) == nullptr);
+
+    // One producer thread always uses the same shard, so its tasks come out
+    // in order no matter where the scan starts
+    for (int64_t n = 1; n <= 100; n++) {
+        queue.push(UniquePtr<Future>(
+            new Future(nullptr, (void *)n, nullptr, nullptr)
+        ));
+    }
+    for (int64_t n = 1; n <= 100; n++) {
+        UniquePtr<Future> popped = queue.pop((uint64_t)n * 7919);
+        assert(popped != nullptr);
+        assert((int64_t)popped->arg == n);
+    }
+    assert(queue.pop(0) == nullptr);
+
+    // Leftovers are deleted with the queue
+    queue.push(UniquePtr<Future>(
+        new Future(nullptr, nullptr, nullptr, nullptr)
+    ));
+}
+
+
+
+void testInjectionPriorities() {
+
+    InjectionQueue queue;
+    TaskPriority priorities[] = {PRIORITY_LOW, PRIORITY_NORMAL, PRIORITY_HIGH};
+
+    // Pushed lowest first; arg is 100 * lane + position in the lane
+    for (TaskPriority priority : priorities) {
+        for (int64_t n = 0; n < 10; n++) {
+            UniquePtr<Future> fut = UniquePtr<Future>(
+                new Future(
+                    nullptr, 
+                    (void *)(100 * priority + n), 
+                    nullptr, 
+                    nullptr
+                )
+            );
+            fut->priority = priority;
+            queue.push(std::move(fut));
+        }
+    }
+
+    // High bits not a multiple of agingPeriod: strictly highest lane first
+    uint64_t noAging = (uint64_t)1 << 32;
+    for (int64_t n = 0; n < 5; n++) {
+        UniquePtr<Future> popped = queue.pop(noAging + n);
+        assert((int64_t)popped->arg == 100 * PRIORITY_HIGH + n);
+    }
+
+    // Aged pops go to the NORMAL lane, then to the LOW lane
+    uint64_t ageNormal = (uint64_t)agingPeriod << 32;
+    uint64_t ageLow = (uint64_t)(agingPeriod * agingPeriod) << 32;
+    UniquePtr<Future> popped = queue.pop(ageNormal);
+    assert((int64_t)popped->arg == 100 * PRIORITY_NORMAL);
+    popped = queue.pop(ageLow);
+    assert((int64_t)popped->arg == 100 * PRIORITY_LOW);
+
+    // The rest comes out lane by lane, in order within each lane
+    for (int64_t n = 5; n < 10; n++) {
+        popped = queue.pop(noAging + n);
+        assert((int64_t)popped->arg == 100 * PRIORITY_HIGH + n);
+    }
+    for (int64_t n = 1; n < 10; n++) {
+        popped = queue.pop(noAging + n);
+        assert((int64_t)popped->arg == 100 * PRIORITY_NORMAL + n);
+    }
+    for (int64_t n = 1; n < 10; n++) {
+        popped = queue.pop(noAging + n);
+        assert((int64_t)popped->arg == 100 * PRIORITY_LOW + n);
+    }
+    assert(queue.pop(noAging) == nullptr);
+    assert(queue.pop(ageLow) == nullptr);
+}
+
+
+
+/**
+ * InjectionStressData class
+ * 
+ * Shared state for the producers and consumers in testInjectionConcurrent.
+ */
+class InjectionStressData final {
+public:
+    InjectionQueue queue;
+    int64_t nTotal;
+    std::atomic<int64_t> nTaken;
+    std::atomic<int64_t> sumTaken;
+};
+
+
+
+/* nStressItems: Number of Futures each producer pushes. */
+static const int64_t nStressItems = 50000;
+
+
+
+static void injectionProducerProc(void *arg) {
+
+    InjectionStressData *data = (InjectionStressData *)arg;
+
+    for (int64_t n = 1; n <= nStressItems; n++) {
+        data->queue.push(UniquePtr<Future>(
+            new Future(nullptr, (void *)n, nullptr, nullptr)
+        ));
+    }
+}
+
+
+
+static void injectionConsumerProc(void *arg) {
+
+    InjectionStressData *data = (InjectionStressData *)arg;
+    uint64_t start = (uint64_t)&start;
+
+    while (data->nTaken.load() < data->nTotal) {
+        UniquePtr<Future> popped = data->queue.pop(start++);
+        if (popped != nullptr) {
+            data->nTaken.fetch_add(1);
+            data->sumTaken.fetch_add((int64_t)popped->arg);
+        }
+    }
+}
+
+
+
+void testInjectionConcurrent() {
+
+    const int nProducers = 4;
+    const int nConsumers = 3;
+
+    InjectionStressData data;
+    data.nTotal = nProducers * nStressItems;
+    data.nTaken.store(0);
+    data.sumTaken.store(0);
+
+    Thread producers[nProducers];
+    Thread consumers[nConsumers];
+    for (int i = 0; i < nConsumers; i++) {
+        consumers[i].start(injectionConsumerProc, &data);
+    }
+    for (int i = 0; i < nProducers; i++) {
+        producers[i].start(injectionProducerProc, &data);
+    }
+    for (int i = 0; i < nProducers; i++) {
+        producers[i].join();
+    }
+    for (int i = 0; i < nConsumers; i++) {
+        consumers[i].join();
+    }
+
+    // Every element was taken exactly once
+    assert(data.nTaken.load() == nProducers * nStressItems);
+    assert(
+        data.sumTaken.load() == 
+            nProducers * nStressItems * (nStressItems + 1) / 2
+    );
+}
@@ -42,4 +42,136 @@ int main() {
     testFuturePopFromList();
     std::printf("testFuturePopFromList succeeded\n\n");
     std::fflush(stdout);
+
+    std::printf("Running testDequePushPop...\n");
+    std::fflush(stdout);
+    testDequePushPop();
+    std::printf("testDequePushPop succeeded\n\n");
+    std::fflush(stdout);
+
+    std::printf("Running testDequeSteal...\n");
+    std::fflush(stdout);
+    testDequeSteal();
+    std::printf("testDequeSteal succeeded\n\n");
+    std::fflush(stdout);
+
+    std::printf("Running testDequeConcurrent...\n");
+    std::fflush(stdout);
+    testDequeConcurrent();
+    std::printf("testDequeConcurrent succeeded\n\n");
+    std::fflush(stdout);
+
+    std::printf("Running testSlabLocalReuse...\n");
+    std::fflush(stdout);
+    testSlabLocalReuse();
+    std::printf("testSlabLocalReuse succeeded\n\n");
+    std::fflush(stdout);
+
+    std::printf("Running testSlabRemoteFree...\n");
+    std::fflush(stdout);
+    testSlabRemoteFree();
+    std::printf("testSlabRemoteFree succeeded\n\n");
+    std::fflush(stdout);
+
+    std::printf("Running testSlabSteadyState...\n");
+    std::fflush(stdout);
+    testSlabSteadyState();
+    std::printf("testSlabSteadyState succeeded\n\n");
+    std::fflush(stdout);
+
+    std::printf("Running testTaskInline...\n");
+    std::fflush(stdout);
+    testTaskInline();
+    std::printf("testTaskInline succeeded\n\n");
+    std::fflush(stdout);
+
+    std::printf("Running testTaskHeapFallback...\n");
+    std::fflush(stdout);
+    testTaskHeapFallback();
+    std::printf("testTaskHeapFallback succeeded\n\n");
+    std::fflush(stdout);
+
+    std::printf("Running testTaskDestroyedUnrun...\n");
+    std::fflush(stdout);
+    testTaskDestroyedUnrun();
+    std::printf("testTaskDestroyedUnrun succeeded\n\n");
+    std::fflush(stdout);
+
+    std::printf("Running testTaskTypedResult...\n");
+    std::fflush(stdout);
+    testTaskTypedResult();
+    std::printf("testTaskTypedResult succeeded\n\n");
+    std::fflush(stdout);
+
+    std::printf("Running testTaskRefs...\n");
+    std::fflush(stdout);
+    testTaskRefs();
+    std::printf("testTaskRefs succeeded\n\n");
+    std::fflush(stdout);
+
+    std::printf("Running testTaskCancelled...\n");
+    std::fflush(stdout);
+    testTaskCancelled();
+    std::printf("testTaskCancelled succeeded\n\n");
+    std::fflush(stdout);
+
+    std::printf("Running testFutureTimedWait...\n");
+    std::fflush(stdout);
+    testFutureTimedWait();
+    std::printf("testFutureTimedWait succeeded\n\n");
+    std::fflush(stdout);
+
+    std::printf("Running testInjectionFifo...\n");
+    std::fflush(stdout);
+    testInjectionFifo();
+    std::printf("testInjectionFifo succeeded\n\n");
+    std::fflush(stdout);
+
+    std::printf("Running testInjectionPriorities...\n");
+    std::fflush(stdout);
+    testInjectionPriorities();
+    std::printf("testInjectionPriorities succeeded\n\n");
+    std::fflush(stdout);
+
+    std::printf("Running testInjectionConcurrent...\n");
+    std::fflush(stdout);
+    testInjectionConcurrent();
+    std::printf("testInjectionConcurrent succeeded\n\n");
+    std::fflush(stdout);
+
+    std::printf("Running testBatchDeque...\n");
+    std::fflush(stdout);
+    testBatchDeque();
+    std::printf("testBatchDeque succeeded\n\n");
+    std::fflush(stdout);
+
+    std::printf("Running testBatchInjectionChain...\n");
+    std::fflush(stdout);
+    testBatchInjectionChain();
+    std::printf("testBatchInjectionChain succeeded\n\n");
+    std::fflush(stdout);
+
+    std::printf("Running testStealTiers...\n");
+    std::fflush(stdout);
+    testStealTiers();
+    std::printf("testStealTiers succeeded\n\n");
+    std::fflush(stdout);
+
+    std::printf("Running testDiscoverCpus...\n");
+    std::fflush(stdout);
+    testDiscoverCpus();
+    std::printf("testDiscoverCpus succeeded\n\n");
+    std::fflush(stdout);
+
+    std::printf("Running testTimerWheelDeadlines...\n");
+    std::fflush(stdout);
+    testTimerWheelDeadlines();
+    std::printf("testTimerWheelDeadlines succeeded\n\n");
+    std::fflush(stdout);
+
+    std::printf("Running testTimerWheelCancelPeriodic...\n");
+    std::fflush(stdout);
+    testTimerWheelCancelPeriodic();
+    std::printf("testTimerWheelCancelPeriodic succeeded\n\n");
+    std::fflush(stdout);
 }
@@ -0,0 +1,70 @@
+/**
+ * TestStealing.cxx
+ */
+
+
+
+#include <memory>
+#include <vector>
+#include <cassert>
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+void testStealTiers() {
+
+    // 2 nodes x 2 clusters x 2 CPUs, handed out in a scrambled order
+    const int nWorkers = 8;
+    uint32_t cpuOrder[nWorkers] = {5, 0, 3, 6, 1, 7, 2, 4};
+    UniquePtr<Worker[]> workers(new Worker[nWorkers]);
+    for (int iWorker = 0; iWorker < nWorkers; iWorker++) {
+        uint32_t cpu = cpuOrder[iWorker];
+        workers[iWorker].place = CpuPlace{cpu, cpu / 4, cpu / 2 * 2};
+    }
+
+    planStealing(workers.get(), nWorkers);
+
+    for (int iWorker = 0; iWorker < nWorkers; iWorker++) {
+        Worker *worker = &workers[iWorker];
+        assert(worker->nSameCluster == 1);
+        assert(worker->nSameNode == 3);
+
+        bool seen[nWorkers] = {};
+        for (int iOrder = 0; iOrder < nWorkers - 1; iOrder++) {
+            int iVictim = worker->stealOrder[iOrder];
+            assert(iVictim != iWorker && !seen[iVictim]);
+            seen[iVictim] = true;
+
+            CpuPlace *victimPlace = &workers[iVictim].place;
+            if (iOrder < worker->nSameCluster) {
+                assert(victimPlace->cluster == worker->place.cluster);
+            }
+            else if (iOrder < worker->nSameNode) {
+                assert(victimPlace->node == worker->place.node);
+                assert(victimPlace->cluster != worker->place.cluster);
+            }
+            else {
+                assert(victimPlace->node != worker->place.node);
+            }
+        }
+    }
+}
+
+
+
+void testDiscoverCpus() {
+
+    // We're running on some CPU, and neighbours come out next to each other
+    std::vector<CpuPlace> cpus = discoverCpus();
+    assert(!cpus.empty());
+    for (size_t iCpu = 1; iCpu < cpus.size(); iCpu++) {
+        assert(cpus[iCpu - 1].node <= cpus[iCpu].node);
+        if (cpus[iCpu - 1].node == cpus[iCpu].node) {
+            assert(cpus[iCpu - 1].cluster <= cpus[iCpu].cluster);
+        }
+    }
+}
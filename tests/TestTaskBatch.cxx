@@ -0,0 +1,109 @@
+/**
+ * TestTaskBatch.cxx
+ */
+
+
+
+#include <memory>
+#include <atomic>
+#include <cassert>
+#include <cstdio>
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/* nBatchTasks: Number of tasks in the test batches. */
+static const uint32_t nBatchTasks = 100;
+
+
+
+/**
+ * fillBatch
+ * 
+ * Gives every Future of batch a task adding its index + 1 to *sum, the way
+ * Winpool::submitBatch does.
+ */
+static void fillBatch(FutureBatch *batch, std::atomic<int64_t> *sum) {
+    for (uint32_t iTask = 0; iTask < batch->nTasks; iTask++) {
+        Future *fut = batch->newFuture(iTask);
+        fut->setTask([sum, batch, iTask]() {
+            sum->fetch_add(iTask + 1);
+            batch->finishTask();
+        });
+    }
+}
+
+
+
+void testBatchDeque() {
+
+    std::atomic<int64_t> sum(0);
+    FutureBatch *batch = FutureBatch::create(nullptr, nBatchTasks, 0);
+    fillBatch(batch, &sum);
+    TaskBatch handle(batch);
+
+    // The whole batch goes in with one bottom store, in order
+    FutureDeque deque;
+    deque.push(UniquePtr<Future>(
+        new Future(nullptr, nullptr, nullptr, nullptr)
+    ));
+    deque.pushBatch(batch);
+    assert(deque.size() == nBatchTasks + 1);
+
+    for (uint32_t iTask = nBatchTasks; iTask > 0; iTask--) {
+        assert(!handle.done());
+        UniquePtr<Future> fut = deque.pop();
+        assert(fut.get() == batch->futureAt(iTask - 1));
+        assert(fut->detached);
+        fut->invokeTask(fut.get());
+    }
+    assert(handle.done());
+    assert(sum.load() == (int64_t)nBatchTasks * (nBatchTasks + 1) / 2);
+
+    // The batch frees itself once the handle is dropped too
+    assert(batch->nRefs.load() == 1);
+    assert(deque.pop() != nullptr);
+}
+
+
+
+void testBatchInjectionChain() {
+
+    std::atomic<int64_t> sum(0);
+    FutureBatch *batch = FutureBatch::create(nullptr, nBatchTasks, 0);
+    fillBatch(batch, &sum);
+
+    // Drop the handle first: the Futures keep the batch alive
+    {
+        TaskBatch handle(batch);
+        TaskBatch moved(std::move(handle));
+        assert(handle.batch == nullptr);
+    }
+    assert(batch->nRefs.load() == nBatchTasks);
+
+    InjectionQueue queue;
+    for (uint32_t iTask = 0; iTask + 1 < nBatchTasks; iTask++) {
+        batch->futureAt(iTask)->queueNext.store(batch->futureAt(iTask + 1));
+    }
+    queue.pushChain(batch->futureAt(0), batch->futureAt(nBatchTasks - 1));
+
+    // Mixing in a single push keeps FIFO order
+    queue.push(UniquePtr<Future>(
+        new Future(nullptr, nullptr, nullptr, nullptr)
+    ));
+
+    for (uint32_t iTask = 0; iTask < nBatchTasks; iTask++) {
+        UniquePtr<Future> fut = queue.pop(iTask);
+        assert(fut.get() == batch->futureAt(iTask));
+        fut->invokeTask(fut.get());
+    }
+    assert(sum.load() == (int64_t)nBatchTasks * (nBatchTasks + 1) / 2);
+
+    UniquePtr<Future> last = queue.pop(0);
+    assert(last != nullptr && !last->detached);
+    assert(queue.pop(0) == nullptr);
+}
@@ -0,0 +1,272 @@
+
+/**
+ * TestTaskStorage.cxx
+ */
+
+
+
+#include <memory>
+#include <array>
+#include <cassert>
+#include <cstdio>
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+/**
+ * Tracker class
+ * 
+ * Counts how often it gets copied, moved and destroyed while captured by a
+ * task.
+ */
+class Tracker {
+public:
+
+    static int nCopies;
+    static int nMoves;
+    static int nDestroyed;
+
+    /* alive: false once this instance has been moved from. */
+    bool alive;
+
+    Tracker() { alive = true; }
+    Tracker(const Tracker &other) { alive = other.alive; nCopies++; }
+    Tracker(Tracker &&other) { alive = other.alive; other.alive = false; nMoves++; }
+    ~Tracker() { if (alive) nDestroyed++; }
+
+    static void reset() { nCopies = 0; nMoves = 0; nDestroyed = 0; }
+};
+
+int Tracker::nCopies = 0;
+int Tracker::nMoves = 0;
+int Tracker::nDestroyed = 0;
+
+
+
+
+void testTaskInline() {
+
+    Tracker::reset();
+
+    UniquePtr<int> owned = UniquePtr<int>(new int(7));
+    Tracker tracker;
+    auto task = [owned = std::move(owned), tracker = std::move(tracker)]() {
+        return (void *)(intptr_t)(*owned * 6);
+    };
+    static_assert(sizeof(task) <= taskStorageSize, "task should fit inline");
+
+    Future *fut = new Future((Winpool *)nullptr);
+    fut->setTask(std::move(task));
+
+    // Moved in, never copied, lives inside the Future
+    assert(Tracker::nCopies == 0);
+    assert(Tracker::nDestroyed == 0);
+
+    fut->invokeTask(fut);
+    assert((intptr_t)fut->res == 42);
+    assert(Tracker::nDestroyed == 1);
+
+    delete fut;
+    assert(Tracker::nDestroyed == 1);
+}
+
+
+
+void testTaskHeapFallback() {
+
+    Tracker::reset();
+
+    char big[128] = { 0 };
+    big[127] = 5;
+    Tracker tracker;
+    auto task = [big, tracker = std::move(tracker)]() {
+        return (void *)(intptr_t)big[127];
+    };
+    static_assert(sizeof(task) > taskStorageSize, "task shouldn't fit inline");
+
+    Future *fut = new Future((Winpool *)nullptr);
+    fut->setTask(std::move(task));
+    assert(Tracker::nCopies == 0);
+
+    fut->invokeTask(fut);
+    assert((intptr_t)fut->res == 5);
+    assert(Tracker::nDestroyed == 1);
+
+    delete fut;
+}
+
+
+
+void testTaskDestroyedUnrun() {
+
+    Tracker::reset();
+
+    Tracker tracker;
+    Future *fut = new Future((Winpool *)nullptr);
+    fut->setTask([tracker = std::move(tracker)]() { return nullptr; });
+
+    // Deleting a Future whose task never ran still destroys the callable
+    delete fut;
+    assert(Tracker::nCopies == 0);
+    assert(Tracker::nDestroyed == 1);
+
+    // Legacy func/arg tasks go through the same storage
+    fut = new Future(
+        [](void *arg) { return arg; }, (void *)9, nullptr, nullptr
+    );
+    fut->invokeTask(fut);
+    assert((intptr_t)fut->res == 9);
+    delete fut;
+}
+
+
+
+void testTaskTypedResult() {
+
+    // Small move-only result: stored inline where the callable was
+    Future *fut = new Future((Winpool *)nullptr);
+    fut->setTask([]() { return UniquePtr<int>(new int(3)); });
+    fut->invokeTask(fut);
+    assert(fut->res == (void *)fut->taskStorage);
+    assert(**(UniquePtr<int> *)fut->res == 3);
+    delete fut;
+
+    // Big result: stored on the heap
+    fut = new Future((Winpool *)nullptr);
+    fut->setTask([]() {
+        std::array<int64_t, 16> arr;
+        arr.fill(11);
+        return arr;
+    });
+    fut->invokeTask(fut);
+    assert(fut->res != (void *)fut->taskStorage);
+    assert((*(std::array<int64_t, 16> *)fut->res)[15] == 11);
+    delete fut;
+
+    // The result is destroyed along with the Future
+    Tracker::reset();
+    fut = new Future((Winpool *)nullptr);
+    fut->setTask([]() { return Tracker(); });
+    fut->invokeTask(fut);
+    assert(Tracker::nDestroyed == 0);
+    delete fut;
+    assert(Tracker::nCopies == 0);
+    assert(Tracker::nDestroyed == 1);
+
+    // submit(func, arg) calls still go to the untyped submit
+    static_assert(
+        IsLegacySubmit<void *(&)(void *), int *>::value, 
+        "func/arg submit should stay untyped"
+    );
+    static_assert(
+        !IsLegacySubmit<int64_t (*)(int, int), int, int>::value,
+        "multi-argument submit should be typed"
+    );
+}
+
+
+
+void testTaskRefs() {
+
+    Worker executor;
+
+    // Handle dropped before the task runs: the executor's release deletes 
+    // the Future, result and all
+    Tracker::reset();
+    Future *fut = new Future((Winpool *)nullptr);
+    fut->setTask([]() { return Tracker(); });
+    assert(fut->nRefs.load() == 2);
+    fut->release();
+    assert(fut->nRefs.load() == 1);
+    executeFuture(UniquePtr<Future>(fut), &executor);
+    assert(Tracker::nDestroyed == 1);
+
+    // Handle still held: the executor only drops the pool's reference, and 
+    // the result lives until the handle lets go
+    Tracker::reset();
+    fut = new Future((Winpool *)nullptr);
+    fut->setTask([]() { return Tracker(); });
+    executeFuture(UniquePtr<Future>(fut), &executor);
+    assert(fut->status.load() == DONE);
+    assert(fut->nRefs.load() == 1);
+    assert(Tracker::nDestroyed == 0);
+    fut->release();
+    assert(Tracker::nDestroyed == 1);
+}
+
+
+
+void testTaskCancelled() {
+
+    Worker executor;
+
+    // Cancelled while queued: the executor skips the task but still 
+    // completes the Future, and destroys the callable
+    Tracker::reset();
+    Tracker tracker;
+    Future *fut = new Future((Winpool *)nullptr);
+    fut->cancellable = true;
+    fut->setTask([tracker = std::move(tracker)]() { return (void *)1; });
+    assert(fut->cancel());
+    assert(!fut->cancel());
+    executeFuture(UniquePtr<Future>(fut), &executor);
+    assert(fut->status.load() == DONE);
+    assert(fut->cancelled);
+    assert(fut->res == nullptr);
+    assert(Tracker::nDestroyed == 1);
+    fut->release();
+
+    // Only cancellable tasks can be cancelled, and only before they run
+    fut = new Future((Winpool *)nullptr);
+    fut->setTask([]() { return (void *)2; });
+    assert(!fut->cancel());
+    fut->cancellable = true;
+    executeFuture(UniquePtr<Future>(fut), &executor);
+    assert(!fut->cancel());
+    assert(!fut->cancelled);
+    assert(fut->res == (void *)2);
+    fut->release();
+
+    // A task under a cancelled token is skipped too; one under a live 
+    // token runs with it as its worker's token, which is put back after
+    CancelToken token;
+    CancelState *bSeen = nullptr;
+    fut = new Future((Winpool *)nullptr);
+    fut->cancellable = true;
+    fut->token = token.state;
+    token.state->addRef();
+    fut->setTask([&bSeen, &executor]() { bSeen = executor.bToken; });
+    executeFuture(UniquePtr<Future>(fut), &executor);
+    assert(bSeen == token.state);
+    assert(executor.bToken == nullptr);
+    assert(!fut->cancelled);
+    fut->release();
+
+    token.cancel();
+    assert(token.cancelled());
+    bSeen = nullptr;
+    fut = new Future((Winpool *)nullptr);
+    fut->cancellable = true;
+    fut->token = token.state;
+    token.state->addRef();
+    fut->setTask([&bSeen, &executor]() { bSeen = executor.bToken; });
+    executeFuture(UniquePtr<Future>(fut), &executor);
+    assert(bSeen == nullptr);
+    assert(fut->cancelled);
+    fut->release();
+    assert(token.state->nRefs.load() == 1);
+
+    // Throwing TaskCancelled gives up: no result, the Future is cancelled 
+    fut = new Future((Winpool *)nullptr);
+    fut->cancellable = true;
+    fut->setTask([]() -> Tracker { throw TaskCancelled(); });
+    executeFuture(UniquePtr<Future>(fut), &executor);
+    assert(fut->status.load() == DONE);
+    assert(fut->cancelled);
+    assert(fut->destroyTask == nullptr);
+    fut->release();
+}
@@ -0,0 +1,117 @@
+/**
+ * TestTimerWheel.cxx
+ */
+
+
+
+#include <memory>
+#include <vector>
+#include <cassert>
+#include <cstdint>
+#include "_winpool_private.hxx"
+
+
+
+using namespace WinpoolNS;
+
+
+
+void testTimerWheelDeadlines() {
+
+    TimerWheel wheel;
+
+    // Start just short of a boundary of every level
+    uint64_t start = ((uint64_t)1 << (timerWheelBits * timerWheelLevels)) - 3;
+    wheel.curTick = start;
+
+    // Deltas landing on every level, on and around block boundaries, and 
+    // one past the top level's span
+    uint64_t deltas[] = {
+        0, 1, 2, 3, 63, 64, 65, 100, 4095, 4096, 4097, 70000, 300000, 
+        20000000, ((uint64_t)1 << (timerWheelBits * timerWheelLevels)) + 5
+    };
+    const int nTimers = sizeof(deltas) / sizeof(deltas[0]);
+    std::vector<Timer *> timers;
+    for (int i = 0; i < nTimers; i++) {
+        Timer *timer = new Timer(nullptr, TimerTask(), 0);
+        timer->deadlineTick = start + deltas[i];
+        wheel.insert(timer);
+        timers.push_back(timer);
+    }
+    assert(wheel.nTimers == (uint64_t)nTimers);
+
+    // Advance in uneven steps: every timer fires in the step that reaches 
+    // its deadline, never earlier or later
+    uint64_t nowTick = start;
+    uint64_t step = 1;
+    int nFired = 0;
+    while (nFired < nTimers) {
+        uint64_t prevTick = wheel.curTick;
+        assert(wheel.nextDueTick() >= prevTick);
+
+        Timer *fired = wheel.advance(nowTick);
+        while (fired != nullptr) {
+            Timer *timer = fired;
+            fired = timer->fireNext;
+            assert(timer->deadlineTick <= nowTick);
+            assert(timer->deadlineTick >= prevTick);
+            assert(timer->iSlot == -1);
+            timer->release();
+            timer->release();
+            nFired++;
+        }
+
+        // Jump straight to the next due tick now and then
+        if (step % 3 == 0 && wheel.nextDueTick() != UINT64_MAX) {
+            nowTick = wheel.nextDueTick();
+        }
+        else {
+            nowTick += step;
+        }
+        step = step * 7 % 1000 + 1;
+    }
+    assert(wheel.nTimers == 0);
+    assert(wheel.nextDueTick() == UINT64_MAX);
+}
+
+
+
+void testTimerWheelCancelPeriodic() {
+
+    TimerWheel wheel;
+
+    // Start on a level 0 block boundary, so the periodic timer's deadline
+    // lands on level 0 whatever the clock says
+    uint64_t start = (uint64_t)1 << (timerWheelBits * timerWheelLevels);
+    wheel.curTick = start;
+
+    Timer *oneShot = new Timer(nullptr, TimerTask(), 0);
+    oneShot->deadlineTick = start + 5000;
+    wheel.insert(oneShot);
+    Timer *periodic = new Timer(nullptr, TimerTask(), 10);
+    periodic->deadlineTick = start + 10;
+    wheel.insert(periodic);
+    assert(wheel.nextDueTick() == start + 10);
+
+    // Cancelled timers never fire
+    wheel.remove(oneShot);
+    assert(oneShot->iSlot == -1);
+    oneShot->release();
+    oneShot->release();
+
+    // Falling behind fires a periodic timer once, then re-arms it past now
+    Timer *fired = wheel.advance(start + 35);
+    assert(fired == periodic && fired->fireNext == nullptr);
+    assert(periodic->iSlot >= 0);
+    assert(periodic->deadlineTick > start + 35);
+    assert(periodic->nRefs.load() == 3);
+    periodic->release();
+
+    fired = wheel.advance(periodic->deadlineTick);
+    assert(fired == periodic);
+    periodic->release();
+
+    // The wheel's destructor disarms it
+    periodic->release();
+    assert(wheel.nTimers == 1);
+}
@@ -0,0 +1,172 @@
+/**
+ * TimedWaits.cxx
+ *
+ * Exercises the non-blocking and timed waits on futures from an external 
+ * thread: what a poll of an unfinished task costs (tryGet and an expired 
+ * waitUntil), an event loop polling many requests at once, and how closely
+ * waitFor keeps to its deadline when the task overruns it.
+ */
+
+
+
+#include <memory>
+#include <atomic>
+#include <cstdio>
+#include <vector>
+#include <algorithm>
+#include <inttypes.h>
+#include <winpool.hxx>
+
+
+
+using namespace WinpoolNS;
+
+
+
+/* N_POLLS: Number of polls timed per kind of poll. */
+#define N_POLLS 1000000
+
+/* N_REQUESTS: Number of requests the event loop polls. */
+#define N_REQUESTS 1000
+
+/* N_DEADLINES: Number of overrunning tasks waited for with a deadline. */
+#define N_DEADLINES 100
+
+/* DEADLINE_MS: Deadline of the waits on overrunning tasks. */
+#define DEADLINE_MS 2
+
+/* OVERRUN_MS: Time the overrunning tasks sleep for. */
+#define OVERRUN_MS 10
+
+
+
+/**
+ * main
+ *
+ * Execution starts here.
+ */
+int main() {
+
+    UniquePtr<Winpool> pool;
+    try {
+        pool = Winpool::createNew(16);
+    }
+    catch (SyscallError e) {
+        std::fprintf(stderr, "syscall failure Winpool::createNew\n");
+        std::fflush(stderr);
+        return 1;
+    }
+
+    // The cost of polling a task that won't be done for a while
+    std::atomic<bool> release(false);
+    TypedFuture<int> blocked = pool->submit([&release]() {
+        while (!release.load()) {
+            sleepMs(1);
+        }
+        return 1;
+    });
+
+    uint64_t startNs = monotonicNs();
+    for (int i = 0; i < N_POLLS; i++) {
+        if (blocked.tryGet()) {
+            std::fprintf(stderr, "tryGet got an unfinished result\n");
+            return 1;
+        }
+    }
+    double tryGetNs = (double)(monotonicNs() - startNs) / N_POLLS;
+
+    startNs = monotonicNs();
+    for (int i = 0; i < N_POLLS; i++) {
+        if (blocked.waitUntil(startNs)) {
+            std::fprintf(stderr, "waitUntil saw an unfinished task done\n");
+            return 1;
+        }
+    }
+    double expiredNs = (double)(monotonicNs() - startNs) / N_POLLS;
+
+    release.store(true);
+    if (blocked.get() != 1) {
+        std::fprintf(stderr, "wrong result after polling\n");
+        return 1;
+    }
+    std::printf(
+        "poll of an unfinished task: tryGet %.1lf ns, "
+            "expired waitUntil %.1lf ns\n",
+        tryGetNs,
+        expiredNs
+    );
+    std::fflush(stdout);
+
+    // An event loop collecting many requests as they complete, in 
+    // whatever order they do
+    std::vector<TypedFuture<uint64_t>> requests;
+    for (int i = 0; i < N_REQUESTS; i++) {
+        requests.push_back(pool->submit([i]() {
+            uint64_t endNs = monotonicNs() + (uint64_t)(i % 7) * 100000;
+            while (monotonicNs() < endNs) {}
+            return (uint64_t)i;
+        }));
+    }
+    uint64_t sum = 0;
+    uint64_t nPolls = 0;
+    size_t nLeft = requests.size();
+    startNs = monotonicNs();
+    while (nLeft > 0) {
+        for (size_t i = 0; i < nLeft; ) {
+            nPolls++;
+            std::optional<uint64_t> res = requests[i].tryGet();
+            if (res) {
+                sum += *res;
+                requests[i] = std::move(requests[--nLeft]);
+                requests.pop_back();
+            }
+            else {
+                i++;
+            }
+        }
+    }
+    double loopMs = (double)(monotonicNs() - startNs) / 1e6;
+    std::printf(
+        "event loop: %d requests in %.1lf ms, %" PRIu64 " polls\n",
+        N_REQUESTS,
+        loopMs,
+        nPolls
+    );
+    std::fflush(stdout);
+    if (sum != (uint64_t)N_REQUESTS * (N_REQUESTS - 1) / 2) {
+        std::fprintf(stderr, "event loop lost results\n");
+        return 1;
+    }
+
+    // Deadlines on tasks that overrun them: how late does waitFor return?
+    std::vector<int64_t> lateNs(N_DEADLINES);
+    for (int i = 0; i < N_DEADLINES; i++) {
+        TypedFuture<void> slow = pool->submit([]() {
+            sleepMs(OVERRUN_MS);
+        });
+        uint64_t waitStartNs = monotonicNs();
+        if (slow.waitFor((uint64_t)DEADLINE_MS * 1000000)) {
+            std::fprintf(stderr, "waitFor saw an overrunning task done\n");
+            return 1;
+        }
+        lateNs[i] = (int64_t)(monotonicNs() - waitStartNs) - 
+                    (int64_t)DEADLINE_MS * 1000000;
+        slow.get();
+    }
+    std::sort(lateNs.begin(), lateNs.end());
+    std::printf(
+        "waitFor(%d ms) on overrunning tasks: returned late by min "
+            "%" PRId64 " us, p50 %" PRId64 " us, p99 %" PRId64 " us\n",
+        DEADLINE_MS,
+        lateNs[0] / 1000,
+        lateNs[N_DEADLINES / 2] / 1000,
+        lateNs[N_DEADLINES * 99 / 100] / 1000
+    );
+    std::fflush(stdout);
+    if (lateNs[0] < 0) {
+        std::fprintf(stderr, "waitFor gave up before its deadline\n");
+        return 1;
+    }
+
+    return 0;
+}
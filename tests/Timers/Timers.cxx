@@ -0,0 +1,166 @@
+/**
+ * Timers.cxx
+ *
+ * Exercises submitAfter and submitEvery: how late timeouts fire, what
+ * arming and cancelling a timer costs, whether a periodic timer keeps its
+ * rate and stops when cancelled, and how much CPU a pool that only waits
+ * for a timer burns.
+ */
+
+
+
+#include <memory>
+#include <atomic>
+#include <cstdio>
+#include <ctime>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+#include <inttypes.h>
+#include <winpool.hxx>
+
+
+
+using namespace WinpoolNS;
+using namespace std::chrono;
+
+
+
+/* N_TIMEOUTS: Number of one-shot timers armed at once. */
+#define N_TIMEOUTS 10000
+
+/* MAX_DELAY_MS: Longest delay of the one-shot timers. */
+#define MAX_DELAY_MS 200
+
+/* N_CANCELLED: Number of timers armed and cancelled right away. */
+#define N_CANCELLED 100000
+
+/* PERIOD_MS: Period of the periodic timer. */
+#define PERIOD_MS 10
+
+/* PERIODIC_RUN_MS: How long the periodic timer is left running. */
+#define PERIODIC_RUN_MS 500
+
+
+
+static int64_t nowNs() {
+    return duration_cast<nanoseconds>(
+        steady_clock::now().time_since_epoch()
+    ).count();
+}
+
+
+
+/**
+ * main
+ *
+ * Execution starts here.
+ */
+int main() {
+
+    UniquePtr<Winpool> pool;
+    try {
+        pool = Winpool::createNew(16);
+    }
+    catch (SyscallError e) {
+        std::fprintf(stderr, "syscall failure Winpool::createNew\n");
+        std::fflush(stderr);
+        return 1;
+    }
+
+    // Many timeouts at once: each records how late it fired
+    std::vector<int64_t> lateNs(N_TIMEOUTS);
+    std::atomic<int> nFired(0);
+    for (int i = 0; i < N_TIMEOUTS; i++) {
+        int64_t delayMs = 1 + (int64_t)i * 7919 % MAX_DELAY_MS;
+        int64_t deadlineNs = nowNs() + delayMs * 1000000;
+        pool->submitAfter(delayMs, [&lateNs, &nFired, i, deadlineNs]() {
+            lateNs[i] = nowNs() - deadlineNs;
+            nFired.fetch_add(1);
+        });
+    }
+    while (nFired.load() < N_TIMEOUTS) {
+        sleepMs(10);
+    }
+    std::sort(lateNs.begin(), lateNs.end());
+    std::printf(
+        "%d timeouts: lateness min %" PRId64 " us, p50 %" PRId64 " us, "
+            "p99 %" PRId64 " us\n",
+        N_TIMEOUTS,
+        lateNs[0] / 1000,
+        lateNs[N_TIMEOUTS / 2] / 1000,
+        lateNs[N_TIMEOUTS * 99 / 100] / 1000
+    );
+    std::fflush(stdout);
+    if (lateNs[0] < 0) {
+        std::fprintf(stderr, "a timer fired early\n");
+        return 1;
+    }
+
+    // Arming and cancelling: constant time, and cancelled timers never run
+    std::atomic<int> nCancelledRan(0);
+    int64_t startNs = nowNs();
+    for (int i = 0; i < N_CANCELLED; i++) {
+        TimerHandle handle = pool->submitAfter(
+            1 + i % 100000,
+            [&nCancelledRan]() {
+                nCancelledRan.fetch_add(1);
+            }
+        );
+        if (!handle.cancel()) {
+            std::fprintf(stderr, "cancel found the timer disarmed\n");
+            return 1;
+        }
+    }
+    double armCancelNs = (double)(nowNs() - startNs) / N_CANCELLED;
+    std::printf("arm + cancel: %.0lf ns per timer\n", armCancelNs);
+    std::fflush(stdout);
+
+    // A periodic timer keeps its rate until it's cancelled
+    std::atomic<int> nTicks(0);
+    TimerHandle periodic = pool->submitEvery(PERIOD_MS, [&nTicks]() {
+        nTicks.fetch_add(1);
+    });
+    sleepMs(PERIODIC_RUN_MS);
+    periodic.cancel();
+    int nTicksAtCancel = nTicks.load();
+    sleepMs(5 * PERIOD_MS);
+    std::printf(
+        "periodic every %d ms: %d runs in %d ms\n",
+        PERIOD_MS,
+        nTicksAtCancel,
+        PERIODIC_RUN_MS
+    );
+    std::fflush(stdout);
+    if (nTicksAtCancel < PERIODIC_RUN_MS / PERIOD_MS * 8 / 10 ||
+            nTicksAtCancel > PERIODIC_RUN_MS / PERIOD_MS + 1 ||
+            nTicks.load() > nTicksAtCancel + 1) {
+        std::fprintf(stderr, "periodic timer ran at the wrong rate\n");
+        return 1;
+    }
+
+    // A pool waiting on a distant timer sleeps until it's due
+    std::atomic<bool> distantFired(false);
+    TimerHandle distant = pool->submitAfter(1500, [&distantFired]() {
+        distantFired.store(true);
+    });
+    sleepMs(100);
+    std::clock_t cpuStart = std::clock();
+    sleepMs(1000);
+    std::clock_t cpuEnd = std::clock();
+    double idleCpuMs =
+        1000.0 * (double)(cpuEnd - cpuStart) / (double)CLOCKS_PER_SEC;
+    while (!distantFired.load()) {
+        sleepMs(10);
+    }
+    std::printf("idle CPU time over 1 s with a timer armed: %lf ms\n",
+                idleCpuMs);
+    std::fflush(stdout);
+
+    if (nCancelledRan.load() != 0) {
+        std::fprintf(stderr, "a cancelled timer ran\n");
+        return 1;
+    }
+
+    return 0;
+}
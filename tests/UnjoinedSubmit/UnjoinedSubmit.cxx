@@ -0,0 +1,134 @@
+/**
+ * UnjoinedSubmit.cxx
+ *
+ * Submits lots of tasks whose results nobody ever gets, from inside a task,
+ * and checks that the pool's Future memory stays flat. Each round does it 
+ * twice: dropping the handles submit returns, then with spawn.
+ */
+
+
+
+#include <memory>
+#include <atomic>
+#include <cstdio>
+#include <chrono>
+#include <thread>
+#include <inttypes.h>
+#include <winpool.hxx>
+
+
+
+using namespace WinpoolNS;
+using namespace std::chrono;
+
+
+
+/* N_ROUNDS: Number of rounds of tasks. */
+#define N_ROUNDS 20
+
+/* ROUND_SIZE: Number of tasks submitted per round. */
+#define ROUND_SIZE 100000
+
+/* MAX_IN_FLIGHT: The submitter waits for its tasks to catch up whenever it
+                  is this far ahead. */
+#define MAX_IN_FLIGHT 1000
+
+/* CHUNK_BLOCKS: Futures per allocator chunk (slabChunkBlocks). */
+#define CHUNK_BLOCKS 256
+
+
+
+/* nDone: Counts finished tasks. */
+static std::atomic<int64_t> nDone(0);
+
+
+
+/**
+ * runRound
+ *
+ * Adds ROUND_SIZE counting tasks from inside a task, with submit (dropping
+ * every handle right away) or spawn, waits for them all and returns the 
+ * tasks run per second.
+ */
+static double runRound(Winpool *bPool, bool useSpawn) {
+
+    steady_clock::time_point start = steady_clock::now();
+
+    int64_t target = nDone.load(std::memory_order_relaxed) + ROUND_SIZE;
+    bPool->submit([bPool, target, useSpawn]() {
+        int64_t nSubmitted = target - ROUND_SIZE;
+        for (int i = 0; i < ROUND_SIZE; i++) {
+            if (useSpawn) {
+                bPool->spawn([]() {
+                    nDone.fetch_add(1, std::memory_order_relaxed);
+                });
+            }
+            else {
+                bPool->submit([]() {
+                    nDone.fetch_add(1, std::memory_order_relaxed);
+                });
+            }
+            nSubmitted++;
+            while (nSubmitted - nDone.load(std::memory_order_relaxed) 
+                    > MAX_IN_FLIGHT) {
+                std::this_thread::yield();
+            }
+        }
+    }).get();
+    while (nDone.load(std::memory_order_relaxed) < target) {
+        std::this_thread::yield();
+    }
+
+    steady_clock::time_point end = steady_clock::now();
+    return ROUND_SIZE / (duration_cast<nanoseconds>(end - start).count() / 1e9);
+}
+
+
+
+/**
+ * main
+ *
+ * Execution starts here.
+ */
+int main() {
+
+    UniquePtr<Winpool> pool;
+    try {
+        pool = Winpool::createNew(16);
+    }
+    catch (SyscallError e) {
+        std::fprintf(stderr, "syscall failure Winpool::createNew\n");
+        std::fflush(stderr);
+        return 1;
+    }
+
+    Winpool *bPool = pool.get();
+    for (int iRound = 0; iRound < N_ROUNDS; iRound++) {
+
+        double submitRate = runRound(bPool, false);
+        double spawnRate = runRound(bPool, true);
+
+        AllocatorStats stats = bPool->allocatorStats();
+
+        std::printf(
+            "round %2d: submit %10.0lf tasks/s, spawn %10.0lf tasks/s, "
+                "Future chunks: %" PRIu64 "\n",
+            iRound,
+            submitRate,
+            spawnRate,
+            stats.nChunks
+        );
+        std::fflush(stdout);
+    }
+
+    // Unjoined Futures are freed as their tasks finish: the chunks only
+    // cover what's in flight, nowhere near every Future ever submitted
+    AllocatorStats stats = bPool->allocatorStats();
+    if (stats.nChunks > 
+            (uint64_t)2 * N_ROUNDS * ROUND_SIZE / CHUNK_BLOCKS / 10) {
+        std::fprintf(stderr, "Future memory kept growing\n");
+        return 1;
+    }
+
+    return 0;
+}
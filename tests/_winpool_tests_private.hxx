@@ -20,6 +20,50 @@ void testPopTail();
 
 void testFuturePopFromList();
 
+void testDequePushPop();
+
+void testDequeSteal();
+
+void testDequeConcurrent();
+
+void testSlabLocalReuse();
+
+void testSlabRemoteFree();
+
+void testSlabSteadyState();
+
+void testTaskInline();
+
+void testTaskHeapFallback();
+
+void testTaskDestroyedUnrun();
+
+void testTaskTypedResult();
+
+void testTaskRefs();
+
+void testTaskCancelled();
+
+void testFutureTimedWait();
+
+void testInjectionFifo();
+
+void testInjectionPriorities();
+
+void testInjectionConcurrent();
+
+void testBatchDeque();
+
+void testBatchInjectionChain();
+
+void testStealTiers();
+
+void testDiscoverCpus();
+
+void testTimerWheelDeadlines();
+
+void testTimerWheelCancelPeriodic();
+
 
 
 #endif // ifndef _WINPOOL_TESTS_PRIVATE_HXX